@@ -2,24 +2,53 @@ QT       += core gui
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
+QT += concurrent # BlockBatcher's software backend
+
 CONFIG += c++17
 
+# Uncomment to show the heap allocations made by each frame's ticks on the
+# F2 HUD (replaces malloc/operator new, see allocationcounter.h)
+#CONFIG += count_allocations
+
+include(core.pri)
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    backendbench.cpp \
+    blockbatcher.cpp \
+    chunkstreamer.cpp \
     dino.cpp \
+    gamecanvas.cpp \
+    gamerenderer.cpp \
+    hudrenderer.cpp \
     main.cpp \
     mainwindow.cpp \
     my_label.cpp \
-    obstacle.cpp
+    obstacle.cpp \
+    rendertarget.cpp \
+    renderworker.cpp \
+    vectorscene.cpp
 
 HEADERS += \
+    backendbench.h \
+    blockbatcher.h \
+    chunkstreamer.h \
     dino.h \
+    gamecanvas.h \
+    gamerenderer.h \
+    hudrenderer.h \
+    inputqueue.h \
     mainwindow.h \
     my_label.h \
-    obstacle.h
+    obstacle.h \
+    rendertarget.h \
+    renderworker.h \
+    spscqueue.h \
+    triplebuffer.h \
+    vectorscene.h
 
 FORMS += \
     mainwindow.ui
@@ -30,4 +59,5 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
 DISTFILES += \
+    dino.sprites.txt \
     dinoStanding.bin
@@ -0,0 +1,59 @@
+#include "allocationcounter.h"
+
+#include <cstdlib>      // For malloc/free
+#include <new>          // For std::bad_alloc
+
+// Per thread, so the render and chunk threads do not show up in a tick's count
+static thread_local quint64 allocationsOnThread = 0;
+
+#if defined(__GLIBC__)
+// glibc lets the program define malloc() and friends itself; these count
+// and forward to glibc's own implementation. Every library in the process
+// (Qt, libstdc++'s operator new) calls them too.
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+void __libc_free(void *p);
+
+void *malloc(std::size_t size) noexcept
+{
+    allocationsOnThread++;
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+    allocationsOnThread++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, std::size_t size) noexcept
+{
+    allocationsOnThread++; // growing a QString or QVector counts
+    return __libc_realloc(p, size);
+}
+
+void free(void *p) noexcept { __libc_free(p); }
+}
+
+bool AllocationCounter::countsMalloc() { return true; }
+
+#else
+// No portable way to hook malloc() here, so Qt's containers and QDebug are missed
+void *operator new(std::size_t size)
+{
+    allocationsOnThread++;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+bool AllocationCounter::countsMalloc() { return false; }
+#endif
+
+quint64 AllocationCounter::count() {
+    return allocationsOnThread;
+}
@@ -0,0 +1,29 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+// Per-thread heap allocation counter, for checking that the per-tick paths
+// allocate nothing. It replaces the process' allocator, so a binary only
+// gets it by asking for it in its .pro file, before include(core.pri):
+//     CONFIG += count_allocations
+// Without that, count() stays 0 and isEnabled() is false.
+//
+// On glibc, malloc(), calloc() and realloc() are counted, which covers
+// operator new, Qt's containers and QDebug alike. Elsewhere only operator
+// new can be replaced, and countsMalloc() is false.
+class AllocationCounter
+{
+public:
+#ifdef DINO_COUNT_ALLOCATIONS
+    static quint64 count(); // allocations made by the calling thread so far
+    static bool countsMalloc();
+    static bool isEnabled() { return true; }
+#else
+    static quint64 count() { return 0; }
+    static bool countsMalloc() { return false; }
+    static bool isEnabled() { return false; }
+#endif
+};
+
+#endif // ALLOCATIONCOUNTER_H
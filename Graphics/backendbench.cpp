@@ -0,0 +1,113 @@
+#include "backendbench.h"
+#include "gameworld.h"
+#include "gamerenderer.h"
+#include "inputlog.h"
+#include "rendertarget.h"
+
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QTextStream>
+#include <QDebug>
+
+// Same "jump when something is close" bot as the soak test, recorded so
+// every backend sees exactly the same frames
+static InputLog botSession(int frames, quint64 seed)
+{
+    InputLog log;
+    log.seed = seed;
+    log.frame_width = GameWorld::DEFAULT_WIDTH;
+    log.frame_height = GameWorld::DEFAULT_HEIGHT;
+    log.gap = GameWorld::DEFAULT_GAP;
+
+    GameWorld world(log.frame_width, log.frame_height, log.gap, seed);
+    for (int t = 0; t < frames; ++t) {
+        if (world.isGameOver) {
+            log.add(quint32(t), InputLog::Restart);
+            world.restartGame();
+        }
+        GameInputs inputs;
+        for (const Obstacle &ob : world.obstacles) {
+            int dist = ob.x - world.dino_x;
+            if (!ob.destroyed && dist > 0 && dist < 12) {
+                inputs.jump = !world.isJumping;
+                break;
+            }
+        }
+        if (inputs.jump) log.add(quint32(t), InputLog::Jump);
+        world.step(inputs);
+    }
+    log.endTick = quint32(frames);
+    return log;
+}
+
+// Replays the log and draws every tick into target; returns the draw time in ns
+static qint64 timeFrames(const InputLog &log, int frames, RenderTarget &target,
+                         GameRenderer::Style style, BlockBatcher::Backend backend)
+{
+    GameWorld world(log.frame_width, log.frame_height, log.gap, log.seed);
+    GameRenderer renderer;
+    renderer.setBackend(backend);
+    renderer.setStyle(style);
+    QSize size(log.frame_width, log.frame_height);
+
+    QElapsedTimer timer;
+    qint64 total = 0;
+    size_t nextEvent = 0;
+    for (int t = 0; t < frames; ++t) {
+        log.replayTick(world, quint32(t), nextEvent);
+
+        timer.start();
+        QPainter painter(&target.device(size));
+        renderer.drawGame(painter, world);
+        painter.end();
+        total += timer.nsecsElapsed();
+    }
+    return total;
+}
+
+int runBackendComparison(int frames, const QString &logPath, quint64 seed)
+{
+    InputLog log;
+    if (!logPath.isEmpty()) {
+        if (!log.load(logPath)) {
+            qWarning() << "Not a valid input log:" << logPath;
+            return 1;
+        }
+        frames = qMin(frames, int(log.endTick));
+    } else {
+        log = botSession(frames, seed);
+    }
+    if (frames <= 0) {
+        qWarning() << "Nothing to render";
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << "style,target,raster,frames,total_ms,us_per_frame,frames_per_s\n";
+
+    const GameRenderer::Style styles[] = { GameRenderer::GridStyle, GameRenderer::VectorStyle };
+    const BlockBatcher::Backend backends[] = { BlockBatcher::PainterBackend, BlockBatcher::SoftwareBackend };
+    for (GameRenderer::Style style : styles) {
+        for (int k = 0; k < RenderTarget::KindCount; ++k) {
+            for (BlockBatcher::Backend backend : backends) {
+                // QPixmap is not a QImage, so the software rasteriser would just fall back to QPainter;
+                // the vector style only uses the batcher for its cached background
+                if (backend == BlockBatcher::SoftwareBackend &&
+                    (k == RenderTarget::Pixmap || style == GameRenderer::VectorStyle)) continue;
+
+                RenderTarget target; // fresh buffer per run, so every run starts with a full repaint
+                target.setKind(RenderTarget::Kind(k));
+                qint64 ns = timeFrames(log, frames, target, style, backend);
+
+                double ms = ns / 1e6;
+                out << (style == GameRenderer::VectorStyle ? "vector" : "grid") << ','
+                    << RenderTarget::kindName(RenderTarget::Kind(k)) << ','
+                    << (backend == BlockBatcher::SoftwareBackend ? "software" : "painter") << ','
+                    << frames << ',' << ms << ',' << ms * 1000.0 / frames << ','
+                    << (ns > 0 ? frames * 1e9 / ns : 0.0) << '\n';
+                out.flush();
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,13 @@
+#ifndef BACKENDBENCH_H
+#define BACKENDBENCH_H
+
+#include <QString>
+
+// "DinoGame --compare-backends N": renders the same N replayed frames once
+// per GameRenderer style, RenderTarget kind and BlockBatcher backend,
+// offscreen, and prints the draw throughput of each as CSV. Replays logPath if given, otherwise a
+// session played by a simple bot with the given seed.
+// Returns the process exit code.
+int runBackendComparison(int frames, const QString &logPath, quint64 seed);
+
+#endif // BACKENDBENCH_H
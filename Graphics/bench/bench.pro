@@ -0,0 +1,28 @@
+# Microbenchmarks for the per-frame hot paths (Qt Test QBENCHMARK).
+# Runs on the offscreen platform and writes bench_results.xml next to the binary
+# unless -o is given, e.g.  bench -o results.csv,csv  or  bench -tickcounter
+QT += core gui testlib concurrent
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../core.pri)
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    ../blockbatcher.cpp \
+    ../dino.cpp \
+    ../gamerenderer.cpp \
+    ../hudrenderer.cpp \
+    ../obstacle.cpp \
+    ../vectorscene.cpp \
+    hotpathbench.cpp
+
+HEADERS += \
+    ../blockbatcher.h \
+    ../dino.h \
+    ../gamerenderer.h \
+    ../hudrenderer.h \
+    ../obstacle.h \
+    ../vectorscene.h
@@ -0,0 +1,266 @@
+#include "gameworld.h"
+#include "gamerenderer.h"
+
+#include <QtTest>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+
+// Times each per-frame hot path on its own, across world sizes.
+// The update steps mutate the world, so every iteration first restores the
+// entities it touches (a plain vector copy, small next to the step itself).
+class HotPathBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void updateObstacles_data() { worldScenarios(); }
+    void updateObstacles();
+    void updateWeapons_data() { worldScenarios(); }
+    void updateWeapons();
+    void streamWorld_data() { worldScenarios(); }
+    void streamWorld();
+    void checkAndHandleCollision_data() { worldScenarios(); }
+    void checkAndHandleCollision();
+
+    void drawGame_data() { renderScenarios(); }
+    void drawGame();
+    void drawGameSoftware_data() { renderScenarios(); }
+    void drawGameSoftware(); // same frames through BlockBatcher::SoftwareBackend
+    void drawGameVector_data() { renderScenarios(); }
+    void drawGameVector(); // same frames as polygons (GameRenderer::VectorStyle)
+    void DrawBackground_data() { renderScenarios(); }
+    void DrawBackground();
+
+private:
+    void worldScenarios();
+    void renderScenarios();
+    static void populate(GameWorld &world, int count);
+};
+
+// --- Scenarios ---
+
+// gap x frame size x entity count
+void HotPathBench::worldScenarios()
+{
+    QTest::addColumn<int>("gap");
+    QTest::addColumn<QSize>("frame");
+    QTest::addColumn<int>("count");
+
+    const int gaps[] = { 1, 5, 10 };
+    const QSize frames[] = { QSize(831, 761), QSize(3840, 2160) };
+    const int counts[] = { 10, 100, 1000 };
+    for (int gap : gaps)
+        for (const QSize &frame : frames)
+            for (int count : counts)
+                QTest::addRow("gap%d-%dx%d-n%d", gap, frame.width(), frame.height(), count)
+                    << gap << frame << count;
+}
+
+// gap x frame size, with 100 obstacles on screen
+void HotPathBench::renderScenarios()
+{
+    QTest::addColumn<int>("gap");
+    QTest::addColumn<QSize>("frame");
+    QTest::addColumn<int>("count");
+
+    const int gaps[] = { 1, 2, 5, 10 };
+    const QSize frames[] = { QSize(831, 761), QSize(1920, 1080), QSize(3840, 2160) };
+    for (int gap : gaps)
+        for (const QSize &frame : frames)
+            QTest::addRow("gap%d-%dx%d", gap, frame.width(), frame.height()) << gap << frame << 100;
+}
+
+// A fresh run with `count` obstacles spread evenly ahead of the dino,
+// so nothing is hit or scored while timing
+void HotPathBench::populate(GameWorld &world, int count)
+{
+    world.restartGame();
+    world.obstacles.clear();
+    int first = world.dino_x + world.obstacle_speed + 8; // hit boxes are obstacle_speed wide
+    int span = world.max_x - first;
+    for (int i = 0; i < count; ++i) {
+        int x = first + int((long long)i * span / count);
+        world.obstacles.push_back(Obstacle(x, 2 + i % 6, false, false));
+    }
+}
+
+// --- World update steps ---
+
+void HotPathBench::updateObstacles()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+    const ObstacleStore start = world.obstacles;
+
+    QBENCHMARK {
+        world.obstacles = start;
+        world.updateObstacles();
+    }
+}
+
+void HotPathBench::updateWeapons()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    // As many fireballs as obstacles, flying above all of them
+    for (int i = 0; i < count; ++i) {
+        Weapon w;
+        w.x = world.dino_x + int((long long)i * (world.max_x - world.dino_x) / count);
+        w.y = world.ground_y - 20;
+        w.used = false;
+        world.weapons.push_back(w);
+    }
+    const WeaponStore start = world.weapons;
+
+    QBENCHMARK {
+        world.weapons = start;
+        world.updateWeapons();
+    }
+}
+
+void HotPathBench::streamWorld()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, 0);
+
+    // `count` ticks of streaming per iteration, with no chunk source, so the
+    // chunks are generated here too: the worst case for the tick. Obstacles
+    // that came in are dropped again, so the pool does not fill up
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i) {
+            world.streamWorld(world.obstacle_speed);
+            world.obstacles.clear();
+        }
+    }
+}
+
+void HotPathBench::checkAndHandleCollision()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    QBENCHMARK {
+        world.checkAndHandleCollision();
+    }
+    QCOMPARE(world.lives, 3); // the scenario must stay hit-free
+}
+
+// --- Rendering ---
+
+void HotPathBench::drawGame()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    // Same target format as GameCanvas' back buffer
+    QImage target(frame, QImage::Format_ARGB32_Premultiplied);
+    GameRenderer renderer;
+    QPainter painter(&target);
+    renderer.drawGame(painter, world); // builds the background cache
+
+    QBENCHMARK {
+        renderer.invalidate(); // time the full repaint, not an empty dirty region
+        renderer.drawGame(painter, world);
+    }
+}
+
+void HotPathBench::drawGameSoftware()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    QImage target(frame, QImage::Format_ARGB32_Premultiplied);
+    GameRenderer renderer;
+    renderer.setBackend(BlockBatcher::SoftwareBackend);
+    QPainter painter(&target);
+    renderer.drawGame(painter, world);
+
+    QBENCHMARK {
+        renderer.invalidate();
+        renderer.drawGame(painter, world);
+    }
+}
+
+void HotPathBench::drawGameVector()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    QImage target(frame, QImage::Format_ARGB32_Premultiplied);
+    GameRenderer renderer;
+    renderer.setStyle(GameRenderer::VectorStyle);
+    QPainter painter(&target);
+    renderer.drawGame(painter, world);
+
+    QBENCHMARK {
+        renderer.invalidate();
+        renderer.drawGame(painter, world);
+    }
+}
+
+void HotPathBench::DrawBackground()
+{
+    QFETCH(int, gap);
+    QFETCH(QSize, frame);
+    QFETCH(int, count);
+
+    GameWorld world(frame.width(), frame.height(), gap);
+    populate(world, count);
+
+    QImage target(frame, QImage::Format_ARGB32_Premultiplied);
+    GameRenderer renderer;
+    QPainter painter(&target);
+    renderer.drawGame(painter, world); // builds the background cache
+
+    QBENCHMARK {
+        renderer.DrawBackground(painter, world);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // No display needed (kiosks, CI)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    // Without an explicit -o, log to the console and to bench_results.xml
+    QStringList args = app.arguments();
+    if (!args.contains("-o"))
+        args << "-o" << "bench_results.xml,xml" << "-o" << "-,txt";
+
+    HotPathBench bench;
+    return QTest::qExec(&bench, args);
+}
+
+#include "hotpathbench.moc"
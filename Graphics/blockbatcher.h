@@ -0,0 +1,61 @@
+#ifndef BLOCKBATCHER_H
+#define BLOCKBATCHER_H
+
+#include <QColor>
+#include <QRect>
+#include <QPainter>
+#include <QImage>
+#include <QRegion>
+#include <vector>
+
+// Collects grid cells for one layer of a frame and draws them with one
+// QPainter::drawRects() call per colour, instead of a setPen/setBrush/drawRect
+// per cell. Neighbouring cells of the same colour are merged into a single
+// rectangle (horizontal runs, or vertical runs like mountain columns).
+//
+// Cells are only grouped within a layer, so call flush() wherever draw order
+// matters (e.g. sun -> far mountains -> near mountains -> game objects).
+//
+// With the Software backend, flush() skips QPainter and writes the pixel
+// spans straight into the painter's QImage, split into horizontal bands that
+// are filled in parallel. Output is pixel-identical (cells are opaque,
+// axis-aligned and unantialiased); targets that are not a 32-bit QImage
+// with an identity transform fall back to drawRects().
+class BlockBatcher
+{
+public:
+    enum Backend { PainterBackend, SoftwareBackend };
+
+    BlockBatcher();
+
+    void setBackend(Backend b) { backend = b; }
+    Backend currentBackend() const { return backend; }
+
+    // Grid origin in pixels (the window position of grid cell (0,0)) and cell size
+    void setGrid(int origin_x, int origin_y, int gap);
+
+    void add(int grid_x, int grid_y, const QColor &c); // Queues one grid-sized block
+    void flush(QPainter &painter); // Draws and clears everything queued so far
+
+private:
+    struct Batch {
+        QRgb color;
+        std::vector<QRect> rects; // kept between frames so capacity is reused
+    };
+
+    Batch &batchFor(QRgb color);
+    QImage *softwareTarget(QPainter &painter) const; // null if the Software path cannot be used
+    void fillSoftware(QImage &image, const QRegion &clip);
+    void fillBand(uchar *bits, qsizetype stride, const QRect &band) const;
+
+    std::vector<Batch> batches;
+    int usedBatches;
+    int lastBatch; // cells usually arrive in runs of one colour
+    int originX, originY;
+    int gap;
+    Backend backend;
+    std::vector<QRect> clipRects; // this flush's clip, for the Software path
+    std::vector<QRect> bands;
+};
+
+#endif // BLOCKBATCHER_H
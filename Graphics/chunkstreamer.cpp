@@ -0,0 +1,61 @@
+#include "chunkstreamer.h"
+
+ChunkStreamer::ChunkStreamer(const WorldGenerator::Config &config)
+    : queue(Lookahead),
+      wantedRun(config.run),
+      config(config),
+      builtQueued(true),
+      timer(nullptr)
+{
+    built.run = config.run;
+    built.index = -1;
+    built.after = WorldGenerator::start(config);
+}
+
+void ChunkStreamer::restart(quint32 run)
+{
+    wantedRun.store(run, std::memory_order_release);
+}
+
+bool ChunkStreamer::take(quint32 run, qint64 index, WorldChunk &out)
+{
+    // Chunks of an old run, or ones the game already built itself, are dropped
+    while (queue.tryPop(popped)) {
+        if (popped.run != run || popped.index < index) continue;
+        if (popped.index > index) return false; // cannot happen while both count up from 0; be safe anyway
+        out = popped;
+        return true;
+    }
+    return false; // not ready; the caller generates it
+}
+
+void ChunkStreamer::start()
+{
+    // Created here so it lives (and fires) on the worker thread
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &ChunkStreamer::fill);
+    timer->start(FillMs);
+    fill();
+}
+
+void ChunkStreamer::fill()
+{
+    quint32 run = wantedRun.load(std::memory_order_acquire);
+    if (run != config.run) { // a new run: start its world from the beginning
+        config.run = run;
+        built.index = -1;
+        built.after = WorldGenerator::start(config);
+        builtQueued = true;
+    }
+
+    for (;;) {
+        if (builtQueued) {
+            ChunkState before = built.after;
+            WorldGenerator::generate(config, before, built.index + 1, built);
+            builtQueued = false;
+        }
+        if (!queue.tryPush(built)) break; // full; keep it for the next fill()
+        builtQueued = true;
+        if (wantedRun.load(std::memory_order_relaxed) != run) break; // restarted meanwhile
+    }
+}
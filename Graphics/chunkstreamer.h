@@ -0,0 +1,49 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+#include "spscqueue.h"
+#include "worldgen.h"
+
+// Builds world chunks ahead of the game on its own QThread and hands them
+// over through a lock-free queue, so a tick only copies a finished chunk
+// instead of generating one. It is only a prefetcher: GameWorld builds a
+// chunk itself whenever the one it needs is not ready (it never waits), and
+// both give the same chunk, so replays do not depend on thread timing.
+//
+//     worker: fill() every FillMs, queue.tryPush() until Lookahead chunks are waiting
+//     GUI:    GameWorld::nextChunk() -> take() -> queue.tryPop()
+class ChunkStreamer : public QObject, public ChunkSource
+{
+    Q_OBJECT
+public:
+    static const int Lookahead = 8; // chunks built ahead, a few screens' worth
+    static const int FillMs = 50;   // a chunk scrolls by in about half a second
+
+    explicit ChunkStreamer(const WorldGenerator::Config &config);
+
+    // --- GUI thread (ChunkSource) ---
+    void restart(quint32 run) override;
+    bool take(quint32 run, qint64 index, WorldChunk &out) override;
+
+public slots:
+    void start(); // call on the worker thread (connect to QThread::started)
+    void fill();  // Tops the queue up
+
+private:
+    SpscQueue<WorldChunk> queue; // worker pushes, GUI thread pops
+    std::atomic<quint32> wantedRun; // set by the GUI thread; the worker starts over when it changes
+
+    // GUI thread only
+    WorldChunk popped; // scratch for stale chunks, so take() leaves `out` alone unless it succeeds
+
+    // Worker thread only
+    WorldGenerator::Config config; // config.run is the run being built
+    WorldChunk built; // newest chunk; built.after leads on to the next
+    bool builtQueued; // built is already in the queue
+    QTimer *timer;
+};
+
+#endif // CHUNKSTREAMER_H
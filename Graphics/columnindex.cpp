@@ -0,0 +1,56 @@
+#include "columnindex.h"
+
+ColumnIndex::ColumnIndex() : mask(0), stamp(1)
+{
+    setCapacity(256);
+}
+
+void ColumnIndex::setCapacity(int columns)
+{
+    unsigned size = 1;
+    while (size < (unsigned)columns) size <<= 1;
+    buckets.assign(size, Slot{0, -1});
+    mask = size - 1;
+    entries.clear();
+    stamp = 1;
+}
+
+void ColumnIndex::clear()
+{
+    entries.clear();
+    if (++stamp == 0) { // wrapped: old stamps could look current again
+        for (Slot &s : buckets) s.stamp = 0;
+        stamp = 1;
+    }
+}
+
+void ColumnIndex::insert(int column, int id)
+{
+    Slot &s = buckets[(unsigned)column & mask];
+    if (s.stamp != stamp) {
+        s.stamp = stamp;
+        s.head = -1;
+    }
+    entries.push_back(Entry{column, id, s.head});
+    s.head = (int)entries.size() - 1;
+}
+
+int ColumnIndex::skipTo(int entry, int column) const
+{
+    while (entry != -1 && entries[entry].column != column) {
+        entry = entries[entry].next;
+    }
+    return entry;
+}
+
+int ColumnIndex::first(int column) const
+{
+    const Slot &s = buckets[(unsigned)column & mask];
+    if (s.stamp != stamp) return -1;
+    return skipTo(s.head, column);
+}
+
+int ColumnIndex::next(int entry) const
+{
+    return skipTo(entries[entry].next, entries[entry].column);
+}
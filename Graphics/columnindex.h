@@ -0,0 +1,47 @@
+#ifndef COLUMNINDEX_H
+#define COLUMNINDEX_H
+
+#include <vector>
+
+// Per-frame broad phase for the grid game: which entities (by index into
+// their vector) sit in which grid column. Columns live in a ring buffer
+// indexed by x, since everything scrolls left and only about one screen of
+// columns is ever populated; clear() is O(1) thanks to a frame stamp.
+//
+// Walk one column like a linked list:
+//     for (int e = index.first(col); e != -1; e = index.next(e))
+//         use(index.id(e));
+class ColumnIndex
+{
+public:
+    ColumnIndex();
+
+    void setCapacity(int columns); // Rounded up to a power of two; should cover the visible world plus spawn margin
+    void reserve(int ids) { entries.reserve(ids); } // Entities per frame, so insert() does not allocate
+    void clear();
+    void insert(int column, int id);
+
+    int first(int column) const; // First entry in the column, or -1
+    int next(int entry) const;   // Next entry in the same column, or -1
+    int id(int entry) const { return entries[entry].id; }
+
+private:
+    struct Entry {
+        int column; // kept so columns that alias in the ring can be told apart
+        int id;
+        int next;
+    };
+    struct Slot {
+        unsigned stamp; // slot is empty unless it equals the current stamp
+        int head;
+    };
+
+    int skipTo(int entry, int column) const;
+
+    std::vector<Slot> buckets;
+    std::vector<Entry> entries; // cleared every frame, capacity is kept
+    unsigned mask;
+    unsigned stamp;
+};
+
+#endif // COLUMNINDEX_H
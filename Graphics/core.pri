@@ -0,0 +1,43 @@
+# Simulation core shared by the game and the headless tools.
+# It only needs QtCore, so it can be built without QtWidgets or a display.
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/columnindex.cpp \
+    $$PWD/entitystore.cpp \
+    $$PWD/gameworld.cpp \
+    $$PWD/inputlog.cpp \
+    $$PWD/profiler.cpp \
+    $$PWD/rng.cpp \
+    $$PWD/spritemask.cpp \
+    $$PWD/spritesheet.cpp \
+    $$PWD/terrain.cpp \
+    $$PWD/worldgen.cpp
+
+HEADERS += \
+    $$PWD/allocationcounter.h \
+    $$PWD/columnindex.h \
+    $$PWD/entitystore.h \
+    $$PWD/gameworld.h \
+    $$PWD/inputlog.h \
+    $$PWD/profiler.h \
+    $$PWD/rng.h \
+    $$PWD/spritemask.h \
+    $$PWD/spritesheet.h \
+    $$PWD/terrain.h \
+    $$PWD/ticktimer.h \
+    $$PWD/worldgen.h
+
+# Sprite sheets, decoded by SpriteSheet. Stored uncompressed so QFile::map()
+# can point straight into the executable instead of unpacking a copy.
+RESOURCES += $$PWD/sprites.qrc
+QMAKE_RESOURCE_FLAGS += -no-compress
+
+# Heap allocation counting (AllocationCounter) replaces the process'
+# allocator, so only binaries that report it opt in, before including this:
+#     CONFIG += count_allocations
+count_allocations {
+    DEFINES += DINO_COUNT_ALLOCATIONS
+    SOURCES += $$PWD/allocationcounter.cpp
+}
@@ -1,4 +1,8 @@
 #include "dino.h"
+#include "gameworld.h" // For GameWorld::TICK_MS
+
+const int Dino::INVINCIBLE_TICKS = TickTimer::ticksFor(Dino::INVINCIBLE_TIMESPAN_MS, GameWorld::TICK_MS);
+const int Dino::FLASH_TICKS = TickTimer::ticksFor(Dino::INVINCIBLE_TIMESPAN_MS / 4, GameWorld::TICK_MS);
 
 Dino::Dino()
     : velocityY(0), onGround(true)
@@ -54,18 +58,20 @@ Dino::Dino(QRect dinoRect,float GRAVITY, float DINO_JUMP_STRENGTH, int GROUND_LE
 
         // Polygon closes by connecting back to (50, GROUND_LEVEL - 20)
     };
+    toLocalSpace();
+    buildMask();
 }
 void Dino::update() {
+    stepEffects();
+
     // Apply GRAVITY if in the air
     if (!onGround) {
         velocityY += GRAVITY;
-        dinoRect.translate(0, static_cast<int>(velocityY));
-        dinoShape.translate(0, static_cast<int>(velocityY));
+        dinoRect.translate(0, static_cast<int>(velocityY)); // the shape follows (it is relative to dinoRect)
 
         // Hit the ground? Stop falling!
         if (dinoRect.bottom() >= GROUND_LEVEL) {
             dinoRect.moveBottom(GROUND_LEVEL);
-            movePolygonBottom(dinoShape,dinoRect.bottom());
             velocityY = 0;
             onGround = true;
             doubleJump=true;
@@ -87,11 +93,13 @@ void Dino::reset() {
     velocityY = 0;
     onGround = true;
     DINO_CLR=Qt::white;
+    invincible = false;
+    invincibleTimer.stop();
+    flashTimer.stop();
     lives=3;
     resetLives();
-    int height = dinoRect.height();
-    dinoRect.moveTo(60, GROUND_LEVEL - height);
-    movePolygonBottom(dinoShape,GROUND_LEVEL);
+    dinoRect.moveBottom(GROUND_LEVEL);
+    dinoRect.moveLeft(60);
 }
 
 void Dino::draw(QPainter &painter) {
@@ -99,18 +107,24 @@ void Dino::draw(QPainter &painter) {
     QBrush brushClr = painter.brush();
     painter.setBrush(DINO_CLR);
     painter.setPen(Qt::black);
+    painter.translate(dinoRect.topLeft()); // one offset instead of moving every vertex
     painter.drawPolygon(dinoShape);
+    painter.translate(-dinoRect.topLeft());
     painter.setBrush(Qt::red);
-    for(QPolygon life:lifeShapeList){
+    for(const QPolygon &life:lifeShapeList){
         painter.drawPolygon(life);
     }
     painter.setBrush(brushClr);
 }
 
 void Dino::invincibilityTimeOut(){
-    QTimer::singleShot(Dino::INVINCIBLE_TIMESPAN_MS,[&](){
-        this->invincible=false;
-    });
+    invincibleTimer.start(INVINCIBLE_TICKS);
+}
+
+// Effects count simulation ticks, so they replay exactly and keep up with headless runs
+void Dino::stepEffects(){
+    if (invincibleTimer.step()) invincible = false;
+    if (flashTimer.step()) takeDamgage(); // next flash, or back to white once invincibility is over
 }
 
 void Dino::decLives(){
@@ -121,6 +135,7 @@ void Dino::decLives(){
 void Dino::takeDamgage(){
     if(!invincible){
         DINO_CLR=Qt::white;
+        flashTimer.stop();
         return;
     }
     if(DINO_CLR!=DAMAGE_CLR){
@@ -128,10 +143,7 @@ void Dino::takeDamgage(){
     } else {
         DINO_CLR = Qt::white;
     }
-    int TIME_SPAN = INVINCIBLE_TIMESPAN_MS/4;
-    QTimer::singleShot(TIME_SPAN,[&](){
-        takeDamgage();
-    });
+    flashTimer.start(FLASH_TICKS); // stepEffects() calls us again
 }
 
 void Dino::resetLives(){
@@ -152,20 +164,72 @@ void Dino::resetLives(){
     return;
 }
 
-void Dino::movePolygonBottom(QPolygon &poly, int newBottomY)
-{
-    if (poly.isEmpty()) return;
+void Dino::moveTo(int left, int bottom){
+    dinoRect.moveBottom(bottom);
+    dinoRect.moveLeft(left);
+}
 
-    // Find current bottom (max y)
-    int currentBottom = poly.first().y();
-    for (const QPoint &p : poly)
-        currentBottom = std::max(currentBottom, p.y());
+void Dino::setLives(int n){
+    if (n == lives && lifeShapeList.size() == std::max(n, 0)) return;
+    lives = n;
+    resetLives();
+}
 
-    // Compute offset
-    int dy = newBottomY - currentBottom;
+void Dino::setFlash(bool on){
+    DINO_CLR = on ? DAMAGE_CLR : QColor(Qt::white);
+}
 
-    // Move polygon vertically
-    poly.translate(0, dy);
+QRect Dino::livesRect() const{
+    QRect r;
+    for (const QPolygon &life : lifeShapeList) r |= life.boundingRect();
+    return r;
 }
 
+// Rounds towards negative infinity, so cells left of / above the anchor work too
+static int floorDiv(int a, int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
 
+void Dino::toLocalSpace()
+{
+    // Built in screen space around GROUND_LEVEL; from now on it is drawn at
+    // dinoRect.topLeft() with the feet on the hitbox's bottom row
+    dinoShape.translate(-dinoRect.topLeft());
+    shapeBox = dinoShape.boundingRect();
+    dinoShape.translate(0, dinoRect.height() - 1 - shapeBox.bottom());
+    shapeBox = dinoShape.boundingRect();
+}
+
+void Dino::buildMask()
+{
+    // The shape never changes in local space, so rasterise it once
+    int left = floorDiv(shapeBox.left(), MASK_CELL);
+    int right = floorDiv(shapeBox.right(), MASK_CELL);
+    int top = floorDiv(shapeBox.top(), MASK_CELL);
+    int bottom = floorDiv(shapeBox.bottom(), MASK_CELL);
+
+    dinoMask = SpriteMask(left, top, right - left + 1, bottom - top + 1);
+    for (int cy = top; cy <= bottom; ++cy) {
+        for (int cx = left; cx <= right; ++cx) {
+            // A cell is solid if its centre is inside the polygon
+            QPoint centre(cx * MASK_CELL + MASK_CELL / 2, cy * MASK_CELL + MASK_CELL / 2);
+            if (dinoShape.containsPoint(centre, Qt::OddEvenFill)) {
+                dinoMask.setCell(cx, cy);
+            }
+        }
+    }
+}
+
+bool Dino::intersects(const PixelObstacle &obstacle) const
+{
+    QRect ob = obstacle.getRect();
+    if (!dinoRect.intersects(ob)) return false; // cheap reject
+    if (dinoMask.isEmpty()) return true; // no shape: the hitbox is all we have
+
+    // Obstacle rect in mask cells, in the shape's local space
+    QRect r = ob.translated(-dinoRect.topLeft());
+    int x1 = floorDiv(r.left(), MASK_CELL), x2 = floorDiv(r.right(), MASK_CELL);
+    int y1 = floorDiv(r.top(), MASK_CELL), y2 = floorDiv(r.bottom(), MASK_CELL);
+    return dinoMask.overlapRect(QPoint(0, 0), x1, y1, x2 - x1 + 1, y2 - y1 + 1) > 0;
+}
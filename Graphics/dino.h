@@ -3,8 +3,9 @@
 
 #include <QRect>
 #include <QPainter>
-#include <QTimer>
 #include "obstacle.h"
+#include "spritemask.h"
+#include "ticktimer.h"
 class Dino {
 
 public:
@@ -12,31 +13,40 @@ public:
     Dino(QRect dinoRect,float GRAVITY, float DINO_JUMP_STRENGTH, int GROUND_LEVEL, float velocityY=0, bool onGround=true);
 
     // --- Core functions ---
-    void update();                // called every frame by your main game loop
+    void update();                // one tick of its own physics and effect timers, for a Dino run on its own
     void draw(QPainter &painter); // paints the dino
     void jump();                  // triggers jump if grounded
     void reset();                 // resets position & velocity
-    bool intersects(Obstacle obstacle){return dinoRect.intersects(obstacle.getRect());};
-    void takeDamgage();
-    void invincibilityTimeOut();
+    bool intersects(const PixelObstacle &obstacle) const; // hitbox first, then the shape's bitmask
+    void takeDamgage();           // starts flashing while invincible
+    void invincibilityTimeOut();  // invincibility ends INVINCIBLE_TICKS from now
     void resetLives();
     void decLives();
+    // --- Placement from outside, for drawing someone else's simulation (see VectorScene) ---
+    void moveTo(int left, int bottom); // moves hitbox and shape so the hitbox's bottom-left is here
+    void setLives(int n);              // rebuilds the life triangles only if n changed
+    void setFlash(bool on);            // damage colour on/off (VectorScene passes GameWorld::dinoFlash)
+    QRect livesRect() const;           // area the life triangles cover
     // --- Simple functions ---
     inline QRect getRect() const { return dinoRect; }
     inline bool isOnGround() const { return onGround; }
     inline bool gameover(){return lives<=0;}
     inline bool isInvincible(){return invincible;}
     void setInvincibility(bool arg){invincible=arg;};
-    int getBottom(){return std::max_element(dinoShape.begin(), dinoShape.end(),[](auto &a, auto &b){ return a.y() < b.y(); })->y();}
+    int getBottom() const { return dinoRect.top() + shapeBox.bottom(); } // lowest point of the shape
 
 
 private:
-    QRect dinoRect;    // hitbox rectangle (x, y, w, h)
-    QPolygon dinoShape;
+    QRect dinoRect;    // hitbox rectangle (x, y, w, h); the only thing that moves
+    QPolygon dinoShape; // local space: relative to dinoRect.topLeft(), bottom on the hitbox's bottom row
+    QRect shapeBox;     // dinoShape.boundingRect(), in the same local space
+    SpriteMask dinoMask; // dinoShape rasterised in MASK_CELL-sized cells, relative to dinoRect.topLeft()
     float velocityY;   // vertical speed (for jumping)
     bool onGround;     // grounded state
     bool doubleJump=true;// for double jump mechanics
     bool invincible=false;
+    TickTimer invincibleTimer; // ends invincibility
+    TickTimer flashTimer;      // toggles DINO_CLR while invincible
     QList<QPolygon> lifeShapeList;
     // constants : sync with mainwindow contants in constructor
     float GRAVITY = 1.f;
@@ -44,11 +54,16 @@ private:
     int GROUND_LEVEL = 350;  // Y-position of the ground
     int lives=3;
     static const int INVINCIBLE_TIMESPAN_MS = 1000; // once hit, a short span of time for invincibility
+    static const int INVINCIBLE_TICKS; // the same in simulation ticks
+    static const int FLASH_TICKS;      // a quarter of it per colour
+    static const int MASK_CELL = 5; // collision mask resolution in pixels
     QColor DINO_CLR = Qt::white;
     constexpr static QColor DAMAGE_CLR = QColor(255, 80, 80);
 
     //functions :
-    void movePolygonBottom(QPolygon &poly, int newBottomY);
+    void toLocalSpace(); // moves dinoShape into local space once, after it is built
+    void stepEffects();
+    void buildMask();
 
 };
 
@@ -0,0 +1,86 @@
+#include "entitystore.h"
+
+// --- ObstacleStore ---
+
+void ObstacleStore::setCapacity(int n)
+{
+    x.reserve(n);
+    height.reserve(n);
+    flags.reserve(n);
+}
+
+void ObstacleStore::clear()
+{
+    x.clear();
+    height.clear();
+    flags.clear();
+    anyDead = false;
+}
+
+void ObstacleStore::push_back(const Obstacle &ob)
+{
+    x.push_back(ob.x);
+    height.push_back(ob.height);
+    flags.push_back((ob.passed ? Passed : 0) | (ob.destroyed ? Destroyed : 0));
+}
+
+void ObstacleStore::compact()
+{
+    if (!anyDead) return;
+
+    // One linear pass: slide every survivor down over the dead ones
+    int n = size(), out = 0;
+    for (int i = 0; i < n; ++i) {
+        if (flags[i] & Dead) continue;
+        x[out] = x[i];
+        height[out] = height[i];
+        flags[out] = flags[i];
+        out++;
+    }
+    x.resize(out);
+    height.resize(out);
+    flags.resize(out);
+    anyDead = false;
+}
+
+// --- WeaponStore ---
+
+void WeaponStore::setCapacity(int n)
+{
+    x.reserve(n);
+    y.reserve(n);
+    used.reserve(n);
+}
+
+void WeaponStore::clear()
+{
+    x.clear();
+    y.clear();
+    used.clear();
+    anyUsed = false;
+}
+
+void WeaponStore::push_back(const Weapon &w)
+{
+    x.push_back(w.x);
+    y.push_back(w.y);
+    used.push_back(w.used ? 1 : 0);
+}
+
+void WeaponStore::compact()
+{
+    if (!anyUsed) return;
+
+    int n = size(), out = 0;
+    for (int i = 0; i < n; ++i) {
+        if (used[i]) continue;
+        x[out] = x[i];
+        y[out] = y[i];
+        used[out] = 0;
+        out++;
+    }
+    x.resize(out);
+    y.resize(out);
+    used.resize(out);
+    anyUsed = false;
+}
@@ -0,0 +1,144 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <QtGlobal>
+#include <algorithm>
+#include <vector>
+
+// Struct to hold all data for an obstacle
+// (a by-value view; the live data is in ObstacleStore)
+struct Obstacle {
+    int x;
+    int height;
+    bool passed; // For score tracking
+    bool destroyed;
+    Obstacle(int x,int height,bool passed,bool destroyed):x(x),height(height),passed(passed),destroyed(destroyed){}
+};
+
+// Weapon struct for fireball / dragon-ball
+// (a by-value view; the live data is in WeaponStore)
+struct Weapon{
+    static int weapon_velocity; // define in cpp
+    int x;      // x position in grid coords
+    int y;      // y position in grid coords (height)
+    bool used;  // true when it hit something or went off-screen
+};
+
+// Read-only iterator that hands out views, so `for (const Obstacle &ob : store)` still works
+template <class Store, class View>
+class StoreIterator
+{
+public:
+    StoreIterator(const Store *store, int index) : store(store), index(index) {}
+    View operator*() const { return (*store)[index]; }
+    StoreIterator &operator++() { ++index; return *this; }
+    bool operator!=(const StoreIterator &other) const { return index != other.index; }
+private:
+    const Store *store;
+    int index;
+};
+
+// Fixed-capacity FIFO: push_back() at the end, pop_front() at the start,
+// indexed oldest first. The storage is allocated once by setCapacity() and
+// reused forever after; it only grows (doubling) if the capacity was too small.
+template <class T>
+class RingBuffer
+{
+public:
+    void setCapacity(int n) { items.assign(std::max(n, 1), T()); head = 0; count = 0; }
+    int capacity() const { return (int)items.size(); }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { head = 0; count = 0; }
+
+    void push_back(const T &v)
+    {
+        if (count == capacity()) grow();
+        items[(head + count) % capacity()] = v;
+        count++;
+    }
+    void pop_front() { head = (head + 1) % capacity(); count--; }
+    T &front() { return items[head]; }
+
+    T &operator[](int i) { return items[(head + i) % capacity()]; }
+    const T &operator[](int i) const { return items[(head + i) % capacity()]; }
+    StoreIterator<RingBuffer, T> begin() const { return StoreIterator<RingBuffer, T>(this, 0); }
+    StoreIterator<RingBuffer, T> end() const { return StoreIterator<RingBuffer, T>(this, count); }
+
+private:
+    void grow()
+    {
+        std::vector<T> bigger(std::max(2 * capacity(), 8));
+        for (int i = 0; i < count; ++i) bigger[i] = (*this)[i];
+        items.swap(bigger);
+        head = 0;
+    }
+
+    std::vector<T> items = std::vector<T>(1);
+    int head = 0; // index of the oldest item in items
+    int count = 0;
+};
+
+// Structure-of-arrays storage for obstacles: one plain array per field, so
+// the per-tick movement loop is a straight `x[i] -= speed` the compiler can
+// vectorise. Removal is kill() during the frame and one stable compact()
+// afterwards (order is kept, it matters for which obstacle is hit first).
+// setCapacity() reserves room for the most obstacles that can be alive at
+// once; clear() and compact() keep it, so a running game never allocates.
+class ObstacleStore
+{
+public:
+    enum Flag : quint8 { Passed = 1, Destroyed = 2, Dead = 4 };
+
+    std::vector<int> x;
+    std::vector<int> height;
+    std::vector<quint8> flags; // Flag bits
+
+    int size() const { return (int)x.size(); }
+    bool empty() const { return x.empty(); }
+    void setCapacity(int n); // reserves every array, see above
+    void clear();
+    void push_back(const Obstacle &ob);
+
+    bool passed(int i) const { return flags[i] & Passed; }
+    bool destroyed(int i) const { return flags[i] & Destroyed; }
+    void setFlag(int i, Flag f) { flags[i] |= f; }
+
+    void kill(int i) { flags[i] |= Dead; anyDead = true; } // removed by the next compact()
+    void compact();
+
+    Obstacle operator[](int i) const { return Obstacle(x[i], height[i], passed(i), destroyed(i)); }
+    StoreIterator<ObstacleStore, Obstacle> begin() const { return StoreIterator<ObstacleStore, Obstacle>(this, 0); }
+    StoreIterator<ObstacleStore, Obstacle> end() const { return StoreIterator<ObstacleStore, Obstacle>(this, size()); }
+
+private:
+    bool anyDead = false;
+};
+
+// Structure-of-arrays storage for fireballs, same scheme (and pooling) as ObstacleStore
+class WeaponStore
+{
+public:
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<quint8> used;
+
+    int size() const { return (int)x.size(); }
+    bool empty() const { return x.empty(); }
+    void setCapacity(int n);
+    void clear();
+    void push_back(const Weapon &w);
+
+    void kill(int i) { used[i] = 1; anyUsed = true; } // removed by the next compact()
+    void compact();
+
+    Weapon operator[](int i) const { return Weapon{x[i], y[i], used[i] != 0}; }
+    StoreIterator<WeaponStore, Weapon> begin() const { return StoreIterator<WeaponStore, Weapon>(this, 0); }
+    StoreIterator<WeaponStore, Weapon> end() const { return StoreIterator<WeaponStore, Weapon>(this, size()); }
+
+private:
+    bool anyUsed = false;
+};
+
+#endif // ENTITYSTORE_H
@@ -0,0 +1,105 @@
+#include "gamecanvas.h"
+
+#include <QPainter>
+
+GameCanvas::GameCanvas(QWidget *parent) : my_label(parent), scaled(false), showDirty(false), profiler(nullptr)
+{
+    // We always cover every pixel ourselves, so skip Qt's background erase
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+QPaintDevice &GameCanvas::backBuffer(const QSize &size)
+{
+    bool resized = (size != target.size());
+    QPaintDevice &device = target.device(size);
+    if (resized) {
+        updateViewport();
+        update();
+    }
+    return device;
+}
+
+void GameCanvas::present(const QRegion &dirty)
+{
+    if (showDirty) {
+        // Also repaint last frame's outlines so they get erased
+        update(toWidget(dirty + debugRegion));
+        debugRegion = dirty;
+    } else {
+        update(toWidget(dirty));
+    }
+}
+
+void GameCanvas::resizeEvent(QResizeEvent *event)
+{
+    my_label::resizeEvent(event);
+    updateViewport(); // Qt repaints the whole widget after a resize anyway
+}
+
+void GameCanvas::updateViewport()
+{
+    QSize buffer = target.size();
+    if (buffer.isEmpty() || size().isEmpty()) return;
+
+    // Largest rect with the buffer's aspect ratio that fits, centred
+    QSize fit = buffer.scaled(size(), Qt::KeepAspectRatio);
+    viewport = QRect(QPoint((width() - fit.width()) / 2, (height() - fit.height()) / 2), fit);
+    scaled = (fit != buffer);
+
+    bufferToWidget = QTransform();
+    bufferToWidget.translate(viewport.x(), viewport.y());
+    bufferToWidget.scale(double(fit.width()) / buffer.width(), double(fit.height()) / buffer.height());
+}
+
+QRegion GameCanvas::toWidget(const QRegion &bufferRegion) const
+{
+    if (!scaled) return bufferRegion.translated(viewport.topLeft());
+
+    // Pad by a pixel: edges of scaled rects land between widget pixels
+    QRegion out;
+    for (const QRect &r : bufferRegion) {
+        out += bufferToWidget.mapRect(r).adjusted(-1, -1, 1, 1);
+    }
+    return out;
+}
+
+void GameCanvas::setShowDirtyRects(bool show)
+{
+    showDirty = show;
+    update(); // draw or erase the outlines straight away
+}
+
+void GameCanvas::paintEvent(QPaintEvent *event)
+{
+    if (target.isEmpty()) return;
+    ProfileScope probe(profiler, Profiler::Present);
+
+    QPainter painter(this);
+
+    // Letterbox bars, if the window's aspect ratio differs from the game's
+    for (const QRect &r : event->region() - viewport) {
+        painter.fillRect(r, Qt::black);
+    }
+
+    // Copy only the areas Qt asked for from the back buffer. Without
+    // SmoothPixmapTransform the scaling is nearest-neighbour, so cells stay sharp
+    painter.setTransform(bufferToWidget);
+    QTransform widgetToBuffer = bufferToWidget.inverted();
+    QRect bufferRect(QPoint(0, 0), target.size());
+    for (const QRect &r : event->region() & viewport) {
+        QRect source = widgetToBuffer.mapRect(r);
+        if (scaled) source = source.adjusted(-1, -1, 1, 1) & bufferRect; // partly covered pixels too
+        target.draw(painter, source);
+    }
+
+    // Debug overlay: outline every rect of the last dirty region
+    if (showDirty) {
+        QPen pen(QColor(255, 0, 255));
+        pen.setCosmetic(true); // one widget pixel wide at any scale
+        painter.setPen(pen);
+        painter.setBrush(Qt::NoBrush);
+        for (const QRect &r : debugRegion) {
+            painter.drawRect(r.adjusted(0, 0, -1, -1));
+        }
+    }
+}
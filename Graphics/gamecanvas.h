@@ -0,0 +1,50 @@
+#ifndef GAMECANVAS_H
+#define GAMECANVAS_H
+
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QRegion>
+#include <QTransform>
+#include "my_label.h"
+#include "profiler.h"
+#include "rendertarget.h"
+
+// The game's frame widget. Instead of receiving a new QPixmap through
+// setPixmap() every tick, it owns one back buffer that the game draws into
+// and simply copies it to the screen in paintEvent(). The buffer's raster
+// format is chosen with setTargetKind().
+//
+// The buffer keeps the game's internal resolution; paintEvent() scales it
+// to the widget (nearest-neighbour, aspect ratio kept, black bars around),
+// so resizing or going fullscreen costs one scaled blit, not more cells.
+class GameCanvas : public my_label
+{
+    Q_OBJECT
+public:
+    explicit GameCanvas(QWidget *parent = nullptr);
+
+    void setTargetKind(RenderTarget::Kind kind) { target.setKind(kind); } // Call before the first frame
+    QPaintDevice &backBuffer(const QSize &size); // Reused every frame; only reallocated when the size changes
+    void present(const QRegion &dirty); // Schedules a repaint of the parts of the buffer (buffer pixels) that changed
+    void setShowDirtyRects(bool show); // Debug overlay outlining what each frame repainted
+    bool showDirtyRects() const { return showDirty; }
+    void setProfiler(Profiler *p) { profiler = p; } // paintEvent() is timed as Profiler::Present
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateViewport(); // Fits the buffer into the widget again
+    QRegion toWidget(const QRegion &bufferRegion) const;
+
+    RenderTarget target;
+    QRect viewport; // where the buffer is shown, in widget pixels
+    QTransform bufferToWidget;
+    bool scaled; // viewport is not the buffer's own size
+    bool showDirty;
+    QRegion debugRegion; // last presented dirty region, outlined when showDirty is on
+    Profiler *profiler;
+};
+
+#endif // GAMECANVAS_H
@@ -0,0 +1,381 @@
+#include "gamerenderer.h"
+
+// C++ Standard Library includes
+#include <cmath>        // For math functions
+#include <cstdlib>      // For std::abs
+#include <algorithm>    // For std::min
+
+GameRenderer::GameRenderer()
+    : style(GridStyle)
+{
+    // Setup colors (the dino's come from its sprite sheet)
+    obstacleColor = QColor(200, 50, 50); // Obstacle
+
+    invalidate();
+}
+
+void GameRenderer::invalidate() {
+    fullRepaint = true;
+}
+
+// --- Grid Helper Functions ---
+// Queues a single block; it is drawn by the next batcher.flush()
+void GameRenderer::draw_grid_box(int x, int y, QColor c) {
+    batcher.add(x, y, c);
+}
+
+// Draws the background grid (currently not called)
+void GameRenderer::draw_grid(QPainter &painter, const GameWorld &world){
+    int gap = world.gap;
+    int frame_width = world.frame_width, frame_height = world.frame_height;
+    painter.setPen(QPen(Qt::black, 1));
+    int centerX = frame_width / 2;
+    int centerY = frame_height / 2;
+    for(int i = centerX; i <= frame_width; i += gap)
+        painter.drawLine(QPoint(i, 0), QPoint(i, frame_height));
+    for(int i = centerX - gap; i >= 0; i -= gap)
+        painter.drawLine(QPoint(i, 0), QPoint(i, frame_height));
+    for(int i = centerY; i <= frame_height; i += gap)
+        painter.drawLine(QPoint(0, i), QPoint(frame_width, i));
+    for(int i = centerY - gap; i >= 0; i -= gap)
+        painter.drawLine(QPoint(0, i), QPoint(frame_width, i));
+}
+
+QRect GameRenderer::gridRect(const GameWorld &world, int x1, int y1, int x2, int y2) const {
+    QPoint topLeft = world.from_grid(x1, y1);
+    QPoint bottomRight = world.from_grid(x2, y2);
+    int half = world.gap / 2;
+    return QRect(topLeft.x() - half, topLeft.y() - half,
+                 bottomRight.x() - topLeft.x() + world.gap, bottomRight.y() - topLeft.y() + world.gap);
+}
+
+QRect GameRenderer::perfRect(const GameWorld &world) const {
+    return QRect(world.frame_width - 175, 110, 175, 82); // just under Score/Lives/Fireballs
+}
+
+// Everything that moves: one rect per dino, shield, obstacle and weapon, one for the terrain band
+QRegion GameRenderer::objectRegion(const GameWorld &world) const {
+    if (style == VectorStyle) return vector.objectRegion();
+    QRegion region;
+
+    // Dino (whether or not it is flickered off this frame) and its shield
+    const SpriteMask &dino = world.dinoSprite().mask;
+    int left = world.dino_x + dino.left(), top = world.dino_y + dino.top();
+    region += gridRect(world, left, top, left + dino.width() - 1, top + dino.height() - 1).translated(0, shift.dinoY);
+    if (world.haveShield) {
+        int r = 5; // drawShield() default radius
+        region += gridRect(world, world.dino_x - r, world.dino_y - 3 - r, world.dino_x + r, world.dino_y - 3 + r)
+                      .translated(0, shift.dinoY);
+    }
+
+    // Obstacles, including destroyed ones that were still drawn last frame
+    for (const Obstacle& ob : world.obstacles) {
+        int floor = world.floorY(ob.x);
+        region += gridRect(world, ob.x, floor - ob.height, ob.x, floor - 1).translated(shift.obstacles, 0);
+    }
+
+    // Terrain scrolls every tick, so the band up to its highest hill is one rect
+    int hills = world.terrain.highest();
+    if (hills > 0) {
+        region += gridRect(world, world.min_x - 5, world.ground_y - hills, world.max_x, world.ground_y - 1)
+                      .translated(shift.obstacles, 0);
+    }
+
+    for (const Weapon &w : world.weapons) {
+        region += gridRect(world, w.x, w.y, w.x + 3, w.y).translated(shift.weapons, 0);
+    }
+    return region;
+}
+
+QRegion GameRenderer::dirtyRegion(const GameWorld &world, const QRegion &objects) {
+    QRect frameRect(0, 0, world.frame_width, world.frame_height);
+    bool overlay = world.isPaused || world.isGameOver;
+    int mountain1X = mountainX(world, world.mountain1Offset, shift.mountain1);
+    int mountain2X = mountainX(world, world.mountain2Offset, shift.mountain2);
+
+    QRegion dirty;
+    if (fullRepaint || overlay || overlay != previousOverlay) {
+        dirty = frameRect; // first frame, resize, or a full-screen overlay came or went
+    } else {
+        // Moving objects: where they were and where they are now
+        dirty = objects + previousObjects;
+
+        // Mountain band scrolls whenever a strip moved
+        if (mountain1X != previousMountain1X || mountain2X != previousMountain2X) {
+            int top = std::min(mountainLayer1.top, mountainLayer2.top);
+            int bottom = std::max(mountainLayer1.top + mountainLayer1.image.height(),
+                                  mountainLayer2.top + mountainLayer2.image.height());
+            dirty += QRect(0, top, world.frame_width, bottom - top);
+        }
+
+        // HUD text only when one of its numbers changed
+        if (world.score != previousScore || world.lives != previousLives || world.fireballCount != previousFireballs) {
+            dirty += QRect(world.frame_width - 175, 10, 175, 100);
+        }
+        if (perfText != previousPerfText) {
+            dirty += perfRect(world);
+        }
+        dirty &= frameRect;
+    }
+
+    fullRepaint = false;
+    previousObjects = objects;
+    previousMountain1X = mountain1X;
+    previousMountain2X = mountain2X;
+    previousScore = world.score;
+    previousLives = world.lives;
+    previousFireballs = world.fireballCount;
+    previousOverlay = overlay;
+    previousPerfText = perfText;
+    return dirty;
+}
+
+// Turns the last tick's motion into pixel offsets: at alpha 0 things are
+// drawn where they were before the tick, at alpha 1 where they are now
+void GameRenderer::computeShift(const GameWorld &world, double alpha) {
+    shift = PixelShift();
+    if (world.isPaused || world.isGameOver) return; // overlays show the exact state
+
+    double back = (1.0 - qBound(0.0, alpha, 1.0)) * world.gap; // pixels per grid unit still to travel
+    const TickMotion &m = world.lastMotion;
+    shift.dinoY = -qRound(back * m.dinoDy);
+    shift.obstacles = qRound(back * m.scroll);
+    shift.weapons = -qRound(back * m.weapon);
+    shift.mountain1 = qRound(back * m.mountain1);
+    shift.mountain2 = qRound(back * m.mountain2);
+}
+
+int GameRenderer::mountainX(const GameWorld &world, int offset, int shiftPx) const {
+    // left edge (pixels) of grid column min_x, i.e. of each strip at offset 0
+    int left = world.min_x * world.gap + world.frame_width/2 - world.gap/2;
+    int x = offset * world.gap + shiftPx;
+    if (x > 0) x -= world.world_width * world.gap; // the strip repeats every world width
+    return left + x;
+}
+
+QRegion GameRenderer::drawGame(QPainter &painter, const GameWorld &world, double alpha) {
+    QRect frameRect(0, 0, world.frame_width, world.frame_height);
+
+    std::array<int, 8> key = { world.frame_width, world.frame_height, world.gap,
+                               world.sunGridX, world.sunGridY, world.sunRadiusGrid,
+                               world.mountain1PeakHeight, world.mountain2PeakHeight };
+    if (key != backgroundKey) {
+        buildBackgroundCache(world); // first frame, restart or resize
+        backgroundKey = key;
+        invalidate();
+    }
+
+    computeShift(world, alpha);
+    if (style == VectorStyle) vector.sync(world, shift.dinoY, shift.obstacles, shift.weapons);
+
+    // Everything below is clipped to what changed since the last frame
+    QRegion dirty = dirtyRegion(world, objectRegion(world));
+    painter.setClipRegion(dirty);
+
+    // draw_grid(painter, world); // Grid is removed
+    DrawBackground(painter, world);
+
+    if (style == VectorStyle) {
+        vector.draw(painter); // one call per entity
+    } else {
+        // Grid cell (0,0) sits in the middle of the frame (see GameWorld::from_grid);
+        // moving layers get their in-between-ticks shift added to the origin
+        int origin_x = world.frame_width/2, origin_y = world.frame_height/2;
+        batcher.setGrid(origin_x, origin_y, world.gap);
+        // Draw Ground
+        for (int x = world.min_x; x <= world.max_x; ++x) {
+            draw_grid_box(x, world.ground_y, QColor(0, 0, 0));
+        }
+
+        batcher.flush(painter); // the dino is blitted on top
+
+        // Draw Dino (with invincibility flicker): this frame's cells, pre-rendered
+        if (!world.dinoFlash) {
+            if (dinoAtlasSheet != world.sprites || dinoAtlasGap != world.gap) buildDinoAtlas(world);
+            const SpriteMask &dino = world.dinoSprite().mask;
+            QPoint topLeft((world.dino_x + dino.left()) * world.gap + origin_x - world.gap/2,
+                           (world.dino_y + dino.top()) * world.gap + origin_y + shift.dinoY - world.gap/2);
+            painter.drawImage(topLeft, dinoAtlas, dinoAtlasRects[world.dinoFrame]);
+        }
+        batcher.setGrid(origin_x, origin_y + shift.dinoY, world.gap);
+        if(world.haveShield){
+            drawShield(world);
+            batcher.flush(painter);
+        }
+            // Draw Obstacles (skip destroyed)
+        batcher.setGrid(origin_x + shift.obstacles, origin_y, world.gap);
+        for (const Obstacle& ob : world.obstacles) {
+            if (ob.destroyed) continue; // don't draw destroyed obstacles
+            for (int i = 0; i < ob.height; ++i) {
+                draw_grid_box(ob.x, world.floorY(ob.x) - 1 - i, obstacleColor);
+            }
+        }
+
+        // --- NEW: Draw Terrain (hills, scrolling with the obstacles) ---
+        for (int x = world.min_x - 5; x <= world.max_x; ++x) {
+            for (int y = world.floorY(x); y < world.ground_y; ++y) {
+                draw_grid_box(x, y, QColor(100,100,100)); // Grey
+            }
+        }
+
+        // --- NEW: Draw Weapons ---
+        batcher.setGrid(origin_x + shift.weapons, origin_y, world.gap);
+        for (const Weapon &w : world.weapons) {
+            if (w.used) continue;
+            // Visually make it look like a fireball (orange)
+            draw_grid_box(w.x, w.y, QColor(255,140,0));
+            draw_grid_box(w.x+1, w.y, QColor(255,165,0));
+            draw_grid_box(w.x+2, w.y, QColor(255,165,0));
+            draw_grid_box(w.x+3, w.y, QColor(255,165,0));
+        }
+        batcher.flush(painter);
+    }
+
+    // Draw UI (Score & Lives & Fireballs)
+    painter.setPen(Qt::black);
+    hud.drawCounters(painter, world.frame_width - 170, world.score, world.lives, world.fireballCount);
+
+    // Profiler HUD (F2)
+    if (!perfText.isEmpty()) {
+        hud.drawPerf(painter, perfRect(world).adjusted(5, 0, 0, 0), perfText);
+    }
+
+    // --- NEW: Draw Paused Screen ---
+    if (world.isPaused) {
+        painter.setBrush(QColor(0,0,0,150)); // Semi-transparent black overlay
+        painter.drawRect(frameRect);
+
+        painter.setPen(Qt::white);
+        hud.drawPaused(painter, frameRect);
+    }
+
+    // Draw Game Over Screen
+    if (world.isGameOver) {
+        painter.setBrush(QColor(0,0,0,150)); // Semi-transparent black overlay
+        painter.drawRect(frameRect);
+
+        painter.setPen(Qt::white);
+        hud.drawGameOver(painter, frameRect);
+    }
+
+    painter.setClipping(false);
+    return dirty;
+}
+
+void GameRenderer::DrawBackground(QPainter &painter, const GameWorld &world){
+    // --- BACKGROUND: Sky + sun, one blit ---
+    painter.drawImage(0, 0, skyLayer);
+
+    // ---- Parallax mountains: blit each strip at its scroll offset ----
+    // far layer: subtle, taller peaks, slower movement
+    painter.drawImage(mountainX(world, world.mountain1Offset, shift.mountain1), mountainLayer1.top, mountainLayer1.image);
+    // near layer: stronger color, lower peaks, moves a bit faster
+    painter.drawImage(mountainX(world, world.mountain2Offset, shift.mountain2), mountainLayer2.top, mountainLayer2.image);
+}
+
+// Renders everything in the background that never changes between frames
+void GameRenderer::buildBackgroundCache(const GameWorld &world){
+    // --- BACKGROUND: Sky ---
+    skyLayer = QImage(world.frame_width, world.frame_height, QImage::Format_RGB32);
+    skyLayer.fill(QColor(135, 206, 235)); // light blue sky
+
+    // ---- STATIC SUN (grid) ----
+    QPainter painter(&skyLayer);
+    batcher.setGrid(world.frame_width/2, world.frame_height/2, world.gap);
+    for (int dx = -world.sunRadiusGrid; dx <= world.sunRadiusGrid; ++dx) {
+        for (int dy = -world.sunRadiusGrid; dy <= world.sunRadiusGrid; ++dy) {
+            if (dx*dx + dy*dy <= world.sunRadiusGrid*world.sunRadiusGrid) {
+                draw_grid_box(world.sunGridX + dx, world.sunGridY + dy, QColor(255, 210, 0));
+            }
+        }
+    }
+    batcher.flush(painter);
+    painter.end();
+
+    buildMountainLayer(mountainLayer1, world, world.mountain1PeakHeight, 0.35, QColor(120,140,160));
+    buildMountainLayer(mountainLayer2, world, world.mountain2PeakHeight, 0.6, QColor(95,120,100));
+}
+
+// Lays every frame of the dino's sprite sheet out in one strip, cells gap pixels wide
+void GameRenderer::buildDinoAtlas(const GameWorld &world){
+    const SpriteSheet &sheet = *world.sprites;
+    int gap = world.gap;
+    int width = 0, height = 0;
+    for (int f = 0; f < sheet.frameCount(); ++f) {
+        width += sheet.frame(f).mask.width() * gap;
+        height = std::max(height, sheet.frame(f).mask.height() * gap);
+    }
+
+    dinoAtlas = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+    dinoAtlas.fill(Qt::transparent);
+    dinoAtlasRects.clear();
+
+    QPainter painter(&dinoAtlas);
+    int x = 0;
+    for (int f = 0; f < sheet.frameCount(); ++f) {
+        const SpriteSheet::Frame &frame = sheet.frame(f);
+        for (size_t c = 0; c < frame.cells.size(); ++c) {
+            QRect cell(x + (frame.cells[c].x() - frame.mask.left()) * gap,
+                       (frame.cells[c].y() - frame.mask.top()) * gap, gap, gap);
+            painter.fillRect(cell, QColor::fromRgba(sheet.palette()[frame.colors[c]]));
+        }
+        dinoAtlasRects.push_back(QRect(x, 0, frame.mask.width() * gap, frame.mask.height() * gap));
+        x += frame.mask.width() * gap;
+    }
+    painter.end();
+
+    dinoAtlasSheet = world.sprites;
+    dinoAtlasGap = gap;
+}
+
+// ---- draw a triangular mountain layer (grid units) into a transparent strip ----
+void GameRenderer::buildMountainLayer(MountainLayer &layer, const GameWorld &world, int peakHeightGrid, double peakFrac, QColor color){
+    int gap = world.gap;
+    int tileWidth = world.world_width;                   // the pattern repeats every world width
+    int halfWidth = tileWidth / 2;                       // how wide the mountain tile is (grid)
+    int baseY = world.ground_y;                          // ground line in grid coords
+    int topY = baseY - peakHeightGrid;                   // highest row a peak can reach
+    int columns = 2 * tileWidth + 1;                     // enough for any offset in (-world_width, 0]
+
+    layer.image = QImage(columns * gap, peakHeightGrid * gap, QImage::Format_ARGB32_Premultiplied);
+    layer.image.fill(Qt::transparent);
+    layer.top = topY * gap + world.frame_height/2 - gap/2;
+
+    QPainter painter(&layer.image);
+    // column min_x / row topY land on the strip's top-left pixel
+    batcher.setGrid(gap/2 - world.min_x * gap, gap/2 - topY * gap, gap);
+
+    // peak X in grid coords (center fraction across world), repeated every tile
+    int peakX = world.min_x + int(peakFrac * tileWidth);
+    for (int x = world.min_x; x < world.min_x + columns; ++x) {
+        // distance to the nearest peak, so neighbouring tiles join seamlessly
+        int dist = std::abs(x - peakX) % tileWidth;
+        dist = std::min(dist, tileWidth - dist);
+        // linear falloff from peak to edges
+        int h = peakHeightGrid - (dist * peakHeightGrid) / halfWidth;
+        if (h <= 0) continue;
+        // draw vertical column of 'h' blocks
+        for (int yy = 0; yy < h; ++yy) {
+            draw_grid_box(x, baseY - 1 - yy, color);
+        }
+    }
+    batcher.flush(painter);
+}
+
+// Draws a circular shield around the dino using its current position
+void GameRenderer::drawShield(const GameWorld &world, int radiusGrid, QColor color)
+{
+    int centerX = world.dino_x;      // dino's current X position
+    int centerY = world.dino_y - 3;  // slightly above feet, roughly center of body
+
+    for (int dx = -radiusGrid; dx <= radiusGrid; ++dx) {
+        for (int dy = -radiusGrid; dy <= radiusGrid; ++dy) {
+            int distSq = dx * dx + dy * dy;
+            int rSq = radiusGrid * radiusGrid;
+            // only draw near the outer edge to form a circle outline
+            if (distSq >= rSq - radiusGrid && distSq <= rSq + radiusGrid) {
+                draw_grid_box(centerX + dx, centerY + dy, color);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef GAMERENDERER_H
+#define GAMERENDERER_H
+
+#include <QPainter>
+#include <QColor>
+#include <QImage>
+#include <QRegion>
+#include <array>
+#include <vector>
+#include "gameworld.h"
+#include "blockbatcher.h"
+#include "hudrenderer.h"
+#include "vectorscene.h"
+
+// Draws a GameWorld into any QPainter. Holds no game state of its own,
+// only drawing helpers, caches and what it drew last frame, which it uses to
+// repaint only the regions that changed (see drawGame()).
+//
+// GridStyle draws the game as grid blocks; VectorStyle draws the same world
+// with the polygon Dino/PixelObstacle classes (see VectorScene). Background,
+// HUD and dirty-rect tracking are shared, so the two can be timed against
+// each other on the same frames.
+class GameRenderer
+{
+public:
+    enum Style { GridStyle, VectorStyle };
+
+    GameRenderer();
+
+    // Draws the game state and returns the region of the target that changed.
+    // Assumes the target still holds the previous frame; everything outside
+    // the returned region is left untouched.
+    // alpha is how far the frame is from the previous tick to the current one
+    // (0..1); moving things are drawn that far along world.lastMotion.
+    QRegion drawGame(QPainter &painter, const GameWorld &world, double alpha = 1.0);
+    void invalidate(); // Forces the next frame to repaint everything
+    void setPerfText(const QString &text) { perfText = text; } // Profiler lines under the HUD; empty hides them
+    void setBackend(BlockBatcher::Backend backend) { batcher.setBackend(backend); } // How grid cells are filled
+    void setStyle(Style s) { style = s; invalidate(); }
+    Style currentStyle() const { return style; }
+
+private:
+    friend class HotPathBench; // bench/ times DrawBackground() on its own
+
+    // One parallax layer, pre-rendered once as a strip two world-widths wide
+    // so any scroll offset is a single blit.
+    struct MountainLayer {
+        QImage image;
+        int top; // window y of the strip's first row
+    };
+
+    // Pixel offsets that put this frame's moving things between ticks
+    struct PixelShift {
+        int dinoY = 0;
+        int obstacles = 0; // obstacles and terrain
+        int weapons = 0;
+        int mountain1 = 0, mountain2 = 0;
+    };
+
+    Style style;
+    BlockBatcher batcher; // Groups this frame's grid cells into drawRects() calls
+    VectorScene vector; // VectorStyle's entities
+    HudRenderer hud; // All text, pre-laid out
+    QColor obstacleColor;
+
+    // Every dino frame pre-rendered at the current gap, side by side; one blit per frame drawn
+    QImage dinoAtlas;
+    std::vector<QRect> dinoAtlasRects; // per sprite frame
+    const SpriteSheet *dinoAtlasSheet = nullptr; // sheet and gap the atlas was built for
+    int dinoAtlasGap = 0;
+
+    // Cached background, rebuilt only when the inputs below change
+    QImage skyLayer; // sky fill + static sun
+    MountainLayer mountainLayer1, mountainLayer2;
+    std::array<int, 8> backgroundKey{}; // frame size, gap, sun and peak heights it was built for
+
+    // Dirty-rectangle tracking: what the previous frame looked like
+    bool fullRepaint;
+    QRegion previousObjects; // dino, shield, obstacles, terrain and weapons last frame
+    PixelShift shift; // for the frame being drawn
+    int previousMountain1X, previousMountain2X; // where the strips were blitted
+    int previousScore, previousLives, previousFireballs;
+    bool previousOverlay; // paused / game over screen was up
+    QString perfText, previousPerfText;
+
+    void draw_grid_box(int x, int y, QColor c); // Queues one grid-sized block
+    void draw_grid(QPainter &painter, const GameWorld &world); // Draws the background grid (currently unused)
+    void DrawBackground(QPainter &painter, const GameWorld &world);
+    void computeShift(const GameWorld &world, double alpha);
+    int mountainX(const GameWorld &world, int offset, int shiftPx) const; // Window x of a strip's left edge
+    void buildBackgroundCache(const GameWorld &world);
+    void buildDinoAtlas(const GameWorld &world);
+    void buildMountainLayer(MountainLayer &layer, const GameWorld &world, int peakHeightGrid, double peakFrac, QColor color);
+    QRect gridRect(const GameWorld &world, int x1, int y1, int x2, int y2) const; // Pixels covered by grid cells x1..x2, y1..y2
+    QRect perfRect(const GameWorld &world) const; // Where the profiler lines go
+    QRegion objectRegion(const GameWorld &world) const;
+    QRegion dirtyRegion(const GameWorld &world, const QRegion &objects);
+    void drawShield(const GameWorld &world, int radiusGrid=5, QColor color=Qt::blue);
+};
+
+#endif // GAMERENDERER_H
@@ -0,0 +1,481 @@
+#include "gameworld.h"
+
+#include <QDebug>       // For printing to console
+
+// C++ Standard Library includes
+#include <cmath>        // For math functions
+#include <algorithm>    // For std::max
+
+// Define static weapon velocity
+int Weapon::weapon_velocity = 2; // moves rightwards (grid units per frame)
+
+const int maxJumps = 2; // For double jump
+
+// fire ball
+const int FIREBALL_WIDTH=5;
+
+GameWorld::GameWorld(int frame_width, int frame_height, int gap, quint64 seed) :
+    frame_width(frame_width),
+    frame_height(frame_height),
+    gap(gap),
+    seed(seed),
+    runNumber(0)
+{
+    // Physics scaled to the grid size
+    double scale_factor = 20.0 / double(gap);
+    gravity = 0.1 * scale_factor;
+    jump_power = -1.2 * scale_factor; // Shorter jump
+
+    // --- MODIFIED: Speed ---
+    base_obstacle_speed = (int)round(scale_factor); // Store the base speed
+    obstacle_speed = base_obstacle_speed; // Set the current speed
+
+    // Dino frames (cells, colours, collision masks) come decoded from dino.sprites
+    sprites = &SpriteSheet::dino();
+
+    // Initialize game world variables
+    min_x = to_grid(0, 0).x();
+    max_x = to_grid(frame_width, 0).x();
+    world_width = max_x - min_x;
+    ground_y = to_grid(0, frame_height * 0.75).y();
+    dino_x = min_x + 10;
+
+    // Everything lives between min_x - 5 and the far end of the terrain ring
+    int streamEnd = max_x + WorldChunk::Width;
+    obstacleColumns.setCapacity(streamEnd - (min_x - 5) + 1);
+
+    // Obstacle spacing is in columns, so difficulty follows distance run, not time
+    worldConfig.seed = seed;
+    worldConfig.minSpacing = 26 * std::max(1, base_obstacle_speed);
+    worldConfig.randomSpacing = 20 * std::max(1, base_obstacle_speed);
+    worldConfig.firstSpawn = worldConfig.minSpacing;
+    worldConfig.multiSpawnFrom = 50 * (worldConfig.minSpacing + worldConfig.randomSpacing / 2); // about 50 points in
+
+    // Pools sized for the most that can be on screen at once, so ticks do
+    // not allocate however long a game runs. Obstacles come in at streamEnd
+    // and leave at min_x - 5; up to 4 spawn per minSpacing columns:
+    int obstacleSpan = streamEnd - (min_x - 5) + 1;
+    obstacles.setCapacity(4 * (obstacleSpan / worldConfig.minSpacing + 1));
+    weapons.setCapacity((world_width + 10) / Weapon::weapon_velocity + 2); // at most one fired per tick
+    obstacleColumns.reserve(obstacles.x.capacity());
+
+    restartGame();
+}
+
+// --- Grid Helper Functions ---
+QPoint GameWorld::to_grid(int curr_x, int curr_y) const {
+    double rel_x = curr_x - frame_width/2, rel_y = curr_y - frame_height/2;
+    rel_x /= (double)gap, rel_y /= (double)gap;
+    return QPoint((int)round(rel_x), (int)round(rel_y));
+}
+
+QPoint GameWorld::from_grid(int grid_x, int grid_y) const {
+    double rel_x = grid_x * gap;
+    double rel_y = grid_y * gap;
+
+    int curr_x = rel_x + frame_width/2;
+    int curr_y = rel_y + frame_height/2;
+
+    return QPoint(curr_x, curr_y);
+}
+
+void GameWorld::restartGame() {
+    // Reset all game variables to their default state
+    score = 0;
+    lives = 3;
+    isGameOver = false;
+    invincibleTimer.stop();
+    flashTimer.stop();
+    dinoFlash = false;
+    isPaused = false; // --- NEW ---
+    isFlying = false; // --- NEW ---
+    haveShield = false;
+
+    // A new world every run: flat ground on screen, then chunks of the
+    // run's own world scroll in from one chunk width past the right edge
+    runNumber++;
+    worldConfig.run = runNumber;
+    obstacles.clear();
+    terrain.reset(min_x - 5, max_x + WorldChunk::Width);
+    chunk.run = runNumber;
+    chunk.index = -1;
+    chunk.after = WorldGenerator::start(worldConfig);
+    chunkColumn = WorldChunk::Width; // take chunk 0 on the first tick
+    if (chunkSource) chunkSource->restart(runNumber);
+
+    dino_y = ground_y - 1;
+    dino_y_velocity = 0;
+    dinoAnimTick = 0;
+    dinoFrame = sprites->frameAt(SpriteSheet::Standing, 0);
+    isJumping = false;
+    jumpCount = 0; // --- NEW: Reset jump count ---
+    obstacle_speed = base_obstacle_speed; // --- NEW: Reset speed ---
+
+    weapons.clear();
+    fireballCount = 3; // give player 3 fireballs at start
+    fireBallsAdded = false;
+    // parallax init (in grid units)
+    mountain1Offset = 0;
+    mountain2Offset = 0;
+    mountain1Speed = std::max(1, obstacle_speed / 2);
+    mountain2Speed = std::max(1, obstacle_speed);
+    lastMotion = TickMotion();
+
+    // peak heights (tweak if needed)
+    mountain1PeakHeight = 18;
+    mountain2PeakHeight = 12;
+
+    // static sun position in grid coordinates (relative to world)
+    sunGridX = min_x + world_width / 4;
+    sunGridY = ground_y - 18;
+    sunRadiusGrid = 6;
+}
+
+void GameWorld::togglePause() {
+    // Pausing only makes sense while a run is in progress
+    if (!isGameOver) {
+        isPaused = !isPaused;
+    }
+}
+
+void GameWorld::startInvincibility() {
+    invincibleTimer.start(INVINCIBLE_TICKS);
+    // Hidden (grid style) for the first FLASH_TICKS, then every other FLASH_TICKS
+    dinoFlash = true;
+    flashTimer.start(FLASH_TICKS);
+}
+
+// Applies the keys pressed since the last tick (Space, F, Enter)
+void GameWorld::applyInputs(const GameInputs &inputs) {
+    if (inputs.jump) {
+        if (isFlying) { // If flying, Space moves dino up
+            dino_y_velocity = jump_power * 0.5; // Gentle boost up
+        }
+        else if (jumpCount < maxJumps) { // Allow double jump
+            jumpCount++;
+            isJumping = true; // Ensure gravity takes effect
+            dino_y_velocity = jump_power; // Apply jump boost
+        }
+    }
+
+    // Handle Fly Cheat
+    if (inputs.toggleFly) {
+        isFlying = !isFlying;
+        if (isFlying) {
+            isJumping = false; // Disable normal jump/gravity logic
+            dino_y_velocity = 0; // Stop falling
+        } else {
+            isJumping = true; // Re-enable gravity
+        }
+        fireballCount=99;
+    }
+
+    // --- NEW: Weapon spawn on Enter/Return ---
+    if (inputs.fire) {
+        spawnWeapon();
+    }
+}
+
+void GameWorld::step(const GameInputs &inputs) {
+    if (isGameOver || isPaused) return; // Don't run logic if game is over or paused
+
+    ProfileScope stepProbe(profiler, Profiler::Step);
+    int startDinoY = dino_y;
+    int tickSpeed = obstacle_speed; // obstacles and terrain move by this before any speed-up below
+
+    applyInputs(inputs);
+
+    // Effects from earlier ticks run out before this tick's collisions
+    if (invincibleTimer.step()) {
+        flashTimer.stop();
+        dinoFlash = false;
+    } else if (flashTimer.step()) {
+        dinoFlash = !dinoFlash;
+        flashTimer.start(FLASH_TICKS);
+    }
+
+    // Run all game logic
+    {
+        ProfileScope probe(profiler, Profiler::Dino);
+        updateDino();
+
+        // Legs move while running; in the air it holds the standing pose
+        SpriteSheet::Animation animation = (isJumping || isFlying) ? SpriteSheet::Standing : SpriteSheet::Running;
+        dinoFrame = sprites->frameAt(animation, dinoAnimTick++);
+    }
+    {
+        ProfileScope probe(profiler, Profiler::Weapons);
+        updateWeapons(); // --- NEW: Update weapons before obstacles ---
+    }
+    {
+        ProfileScope probe(profiler, Profiler::Obstacles);
+        updateObstacles();
+    }
+    {
+        // Obstacles stand on the terrain, so both scroll in the same tick
+        ProfileScope probe(profiler, Profiler::Stream);
+        streamWorld(tickSpeed);
+    }
+    {
+        ProfileScope probe(profiler, Profiler::Collision);
+        checkAndHandleCollision();
+    }
+
+    // parallax offsets (grid units) with wrap-around
+    mountain1Offset -= mountain1Speed;
+    mountain2Offset -= mountain2Speed;
+
+    if (mountain1Offset <= -world_width) mountain1Offset += world_width;
+    if (mountain2Offset <= -world_width) mountain2Offset += world_width;
+
+    lastMotion.dinoDy = dino_y - startDinoY;
+    lastMotion.scroll = tickSpeed;
+    lastMotion.weapon = Weapon::weapon_velocity;
+    lastMotion.mountain1 = mountain1Speed;
+    lastMotion.mountain2 = mountain2Speed;
+
+    if(score%15==0){
+        haveShield=true;
+    }
+
+    if (lives <= 0 && !isGameOver) { // Check for game over condition
+        gameOver();
+    }
+}
+
+void GameWorld::gameOver() {
+    isGameOver = true;
+    qDebug() << "GAME OVER! Final Score:" << score;
+}
+
+// --- Broad phase: rebuilt whenever the vectors they index have changed ---
+void GameWorld::indexObstacles() {
+    obstacleColumns.clear();
+    for (int i = 0; i < obstacles.size(); ++i) {
+        obstacleColumns.insert(obstacles.x[i], i);
+    }
+}
+
+// --- Game Logic ---
+
+void GameWorld::updateDino() {
+    // --- MODIFIED: Fly Cheat Logic ---
+    if (isFlying) {
+        // While flying, gravity is OFF.
+        // We apply a little "air friction" so you don't
+        // drift forever after tapping Space.
+        dino_y_velocity *= 0.9; // Instead of adding gravity, we add drag.
+
+        dino_y += dino_y_velocity;
+
+        // Don't let dino fly off the top
+        if (dino_y < to_grid(0,0).y() + 5) {
+            dino_y = to_grid(0,0).y() + 5;
+            dino_y_velocity = 0;
+        }
+
+        // Don't let dino fall through floor
+        int floor_y = standingY();
+        if (dino_y >= floor_y) {
+            dino_y = floor_y;
+            dino_y_velocity = 0;
+        }
+        return; // Skip normal jump logic
+    }
+
+    // --- MODIFIED: Terrain under the feet is the ground ---
+    int landing_y = standingY();
+
+    // Walking: follow the hills up and down (slopes are at most one cell per column)
+    if (!isJumping) {
+        dino_y = landing_y;
+    }
+
+    // Normal jump logic
+    if (isJumping) {
+        dino_y_velocity += gravity;
+        dino_y += dino_y_velocity;
+
+        if (dino_y >= landing_y) { // Check for landing
+            dino_y = landing_y;
+            isJumping = false;
+            dino_y_velocity = 0;
+            jumpCount = 0;
+        }
+    }
+}
+
+int GameWorld::standingY() const {
+    // (dino_x-2, dino_x-1, dino_x) are the main X coords for feet
+    int top = ground_y;
+    for (int col = dino_x - 2; col <= dino_x; ++col) {
+        top = std::min(top, floorY(col));
+    }
+    return top - 1;
+}
+
+void GameWorld::updateObstacles() {
+    // Move every obstacle left; destroyed ones too, so they go off-screen.
+    // A speed-up earned below takes effect from the next tick.
+    int n = obstacles.size();
+    int *xs = obstacles.x.data();
+    for (int i = 0; i < n; ++i) {
+        xs[i] -= obstacle_speed;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (!(obstacles.flags[i] & (ObstacleStore::Passed | ObstacleStore::Destroyed)) && xs[i] < dino_x) { // Check for scoring
+            obstacles.setFlag(i, ObstacleStore::Passed);
+            score++;
+
+            // --- NEW: Increase speed on score milestones ---
+            if (score > 0 && score % 25 == 0) {
+                obstacle_speed = base_obstacle_speed + (score / 25);
+                qDebug() << "Speed Increased! New speed:" << obstacle_speed;
+            }
+        }
+
+        if (xs[i] < min_x - 5) { // Remove if off-screen
+            obstacles.kill(i);
+        }
+    }
+    obstacles.compact(); // one linear pass for everything that left the screen
+}
+
+void GameWorld::streamWorld(int columns) {
+    for (int i = 0; i < columns; ++i) {
+        if (chunkColumn == WorldChunk::Width) nextChunk();
+        terrain.scrollIn(chunk.heights[chunkColumn]);
+
+        // Obstacles are placed as their column comes in, standing on it
+        for (int k = 0; k < chunk.obstacleCount; ++k) {
+            if (chunk.obstacleColumn[k] == chunkColumn) {
+                // Already moved this tick, so it lands where it would have scrolled to
+                int x = terrain.lastColumn() - (columns - 1 - i);
+                obstacles.push_back(Obstacle{x, chunk.obstacleHeight[k], false, false});
+            }
+        }
+        chunkColumn++;
+    }
+}
+
+void GameWorld::nextChunk() {
+    // A prefetched chunk if the source has it ready, else build it here; the
+    // result is the same either way, so replays do not depend on threads
+    qint64 index = chunk.index + 1;
+    if (!chunkSource || !chunkSource->take(runNumber, index, chunk)) {
+        ChunkState before = chunk.after;
+        WorldGenerator::generate(worldConfig, before, index, chunk);
+    }
+    chunkColumn = 0;
+}
+
+void GameWorld::checkAndHandleCollision() {
+    if (isInvincible()) return; // Can't be hit if invincible
+
+    indexObstacles(); // obstacles moved in updateObstacles() and came in with streamWorld()
+
+    QPoint dinoPos(dino_x, dino_y);
+    const SpriteMask &dinoMask = dinoSprite().mask;
+    int dinoLeft = dino_x + dinoMask.left();
+    int dinoRight = dinoLeft + dinoMask.width() - 1;
+
+    // Obstacles move obstacle_speed columns per tick, so each one covers
+    // [ob.x, ob.x + obstacle_speed) horizontally and its height vertically.
+    int hits = 0; // overlapping dino blocks, over all obstacles
+    int hitIndex = -1; // first obstacle hit
+    for (int col = dinoLeft - obstacle_speed + 1; col <= dinoRight; ++col) {
+        for (int e = obstacleColumns.first(col); e != -1; e = obstacleColumns.next(e)) {
+            int i = obstacleColumns.id(e);
+            if (obstacles.destroyed(i)) continue; // ignore destroyed obstacles
+
+            int height = obstacles.height[i];
+            int n = dinoMask.overlapRect(dinoPos, obstacles.x[i], floorY(obstacles.x[i]) - height, obstacle_speed, height);
+            if (n > 0) {
+                if (hitIndex < 0) hitIndex = i;
+                hits += n;
+            }
+        }
+    }
+    if (hits == 0) return;
+
+    // --- COLLISION! ---
+    startInvincibility();
+    if(haveShield){
+        // The shield soaks up the first overlapping block; any further overlap still hurts
+        haveShield=false;
+        score++;
+        if (hits == 1) return;
+    }
+    lives--;
+    // mark obstacle removed/destroyed
+    // (we erase it here to avoid double-collisions)
+    obstacles.kill(hitIndex);
+    obstacles.compact();
+}
+
+// --- NEW: Weapon handling ---
+void GameWorld::spawnWeapon() {
+    if (fireballCount <= 0) return; // no ammo
+
+    // spawn at dino's head height (we'll use dino_y as "base" height)
+    Weapon w;
+    w.x = dino_x + 2; // a bit in front of the dino
+    w.y = dino_y - 3;     // same height as the dino's reference point (front foot)
+    w.used = false;
+    weapons.push_back(w);
+    fireballCount--;
+    qDebug() << "Fired! Remaining:" << fireballCount;
+}
+
+void GameWorld::updateWeapons() {
+    // move weapons and check collisions
+    if(score%10==0){
+        if(!fireBallsAdded){
+            fireballCount+=3;
+        }
+        fireBallsAdded = true;
+    }
+    else {fireBallsAdded=false;}
+    indexObstacles(); // obstacles have not moved yet this tick
+
+    // Used weapons were removed at the end of last tick, so move them all rightwards
+    int n = weapons.size();
+    int *xs = weapons.x.data();
+    for (int i = 0; i < n; ++i) {
+        xs[i] += Weapon::weapon_velocity;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        // if off-screen, mark used
+        if (xs[i] > max_x + 5) {
+            weapons.kill(i);
+            continue;
+        }
+
+        // check collision with obstacles whose x is within FIREBALL_WIDTH behind the weapon
+        int wy = weapons.y[i];
+        for (int col = xs[i] - FIREBALL_WIDTH; col <= xs[i] && !weapons.used[i]; ++col) {
+            for (int e = obstacleColumns.first(col); e != -1; e = obstacleColumns.next(e)) {
+                int j = obstacleColumns.id(e);
+                if (obstacles.destroyed(j)) continue;
+
+                int ob_top_y = floorY(obstacles.x[j]) - obstacles.height[j];
+                int ob_bottom_y = floorY(obstacles.x[j]) - 1;
+
+                if (wy >= ob_top_y && wy <= ob_bottom_y) {
+                    // hit!
+                    obstacles.setFlag(j, ObstacleStore::Destroyed); // set destroyed boolean as requested
+                    obstacles.setFlag(j, ObstacleStore::Passed); // so it won't increment score later
+                    this->score++;
+                    weapons.kill(i);
+                    qDebug() << "Weapon hit obstacle at index" << j << "-> destroyed";
+                    break; // weapon consumed
+                }
+            }
+        }
+    }
+
+    // remove used/offscreen weapons in one pass to keep the store small
+    weapons.compact();
+}
@@ -0,0 +1,152 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include <QPoint>
+#include <vector>
+#include "columnindex.h"
+#include "entitystore.h"
+#include "profiler.h"
+#include "spritemask.h"
+#include "spritesheet.h"
+#include "terrain.h"
+#include "ticktimer.h"
+#include "worldgen.h"
+
+// Key presses collected since the last tick, applied at the start of step()
+struct GameInputs {
+    bool jump = false;      // Space
+    bool toggleFly = false; // F (fly cheat)
+    bool fire = false;      // Enter / Return
+};
+
+// How far things moved during the last tick (grid units), so the renderer
+// can draw in-between positions when frames land between ticks
+struct TickMotion {
+    int dinoDy = 0;    // change in dino_y
+    int scroll = 0;    // obstacles and terrain moved left by this much
+    int weapon = 0;    // weapons moved right by this much
+    int mountain1 = 0; // parallax layers moved left by this much
+    int mountain2 = 0;
+};
+
+// The whole game simulation, with no QWidget or QPainter dependency.
+// MainWindow drives it from its QTimer and draws the public state;
+// headless tools (soak tests, bots) can call step() as fast as they like.
+class GameWorld
+{
+public:
+    GameWorld(int frame_width, int frame_height, int gap, quint64 seed = 1);
+
+    void restartGame(); // Resets all game variables for a new run
+    static const int TICK_MS = 33; // Length of one simulation tick; every speed below is per tick
+    // The game's internal resolution; the window scales the finished frame to fit
+    static const int DEFAULT_WIDTH = 831, DEFAULT_HEIGHT = 761, DEFAULT_GAP = 5;
+    void step(const GameInputs &inputs); // Advances the game by one fixed tick (TICK_MS)
+    void togglePause();
+    void startInvincibility(); // After a hit: no further hits for a while, and the dino flickers
+
+    // --- Grid helpers ---
+    QPoint to_grid(int curr_x, int curr_y) const; // Converts window pixels to grid units
+    QPoint from_grid(int grid_x, int grid_y) const; // Converts grid units to window pixels
+
+    // --- State (read by the renderer, written only by the world) ---
+
+    // UI, Frame, & Grid
+    int frame_width, frame_height;
+    int gap; // The size of one "pixel" in our game
+
+    // Randomness: the world is generated from seed and the run number, so seed + keys = the whole run
+    quint64 seed;
+    quint32 runNumber; // counts restarts, so every run gets a different world
+    WorldGenerator::Config worldConfig; // how chunks are built (a ChunkSource needs the same)
+
+    // Game State
+    bool isGameOver;
+    bool isPaused;
+    static const int INVINCIBLE_TICKS = 50; // how long a hit protects the dino
+    static const int FLASH_TICKS = 5; // the dino flickers in this many ticks on, this many off
+    TickTimer invincibleTimer; // running while the dino can't be hit
+    TickTimer flashTimer; // flips dinoFlash while invincible
+    bool dinoFlash; // this tick's flicker phase: the grid style hides the dino, the vector style tints it
+    bool isInvincible() const { return invincibleTimer.isActive(); }
+    int score;
+    int lives;
+
+    // World
+    int ground_y;
+    int min_x, max_x; // Left and right edges of the screen in grid units
+    int world_width;
+
+    // Dino
+    int dino_x, dino_y; // Dino's base position (front foot)
+    const SpriteSheet *sprites; // the dino's animation frames (SpriteSheet::dino())
+    int dinoFrame; // frame of sprites being shown
+    int dinoAnimTick; // ticks into the current animation
+    const SpriteSheet::Frame &dinoSprite() const { return sprites->frame(dinoFrame); } // cells and mask, relative to the front foot
+    double dino_y_velocity;
+    bool isJumping;
+    bool isFlying; // Fly cheat
+    int jumpCount;
+    bool haveShield;
+
+    // Physics
+    double gravity;
+    double jump_power;
+    int base_obstacle_speed;
+    int obstacle_speed;
+
+    // Obstacles
+    ObstacleStore obstacles;
+
+    // Rolling hills; things stand on them rather than on ground_y
+    Terrain terrain;
+    int floorY(int column) const { return ground_y - terrain.height(column); } // First solid row in a column
+
+    // weapons
+    WeaponStore weapons;
+    int fireballCount; // number of fireballs the player currently has
+    bool fireBallsAdded;
+
+    // background
+    // parallax (grid units)
+    int mountain1Offset = 0;   // offset in grid units (can be negative)
+    int mountain2Offset = 0;
+    int mountain1Speed = 1;    // grid units per frame
+    int mountain2Speed = 2;
+    int mountain1PeakHeight = 18; // height in grid blocks
+    int mountain2PeakHeight = 12;
+
+    TickMotion lastMotion; // zero after a restart
+
+    Profiler *profiler = nullptr; // optional; times each phase of step() when set
+    ChunkSource *chunkSource = nullptr; // optional; chunks built ahead of time (else made in step())
+
+    // static sun (grid coords & radius)
+    int sunGridX = 0;
+    int sunGridY = 0;
+    int sunRadiusGrid = 6;
+
+private:
+    friend class HotPathBench; // bench/ times the update steps one at a time
+
+    // Broad phase: obstacles by grid column
+    ColumnIndex obstacleColumns;
+    void indexObstacles();
+
+    void applyInputs(const GameInputs &inputs);
+    void updateDino(); // Handles dino's jump physics
+    int standingY() const; // dino_y when standing on whatever is under its feet
+    void updateObstacles(); // Moves, scores, and removes obstacles
+
+    // World streaming: terrain and obstacles come in on the right one chunk column at a time
+    WorldChunk chunk; // the one being scrolled in; chunk.after leads on to the next
+    int chunkColumn; // next column of chunk to scroll in
+    void streamWorld(int columns); // Scrolls in the next columns
+    void nextChunk();
+    void checkAndHandleCollision(); // Checks for hits and updates lives
+    void updateWeapons();
+    void spawnWeapon();
+    void gameOver(); // Sets game over state
+};
+
+#endif // GAMEWORLD_H
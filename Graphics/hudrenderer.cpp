@@ -0,0 +1,91 @@
+#include "hudrenderer.h"
+
+#include <QFontMetrics>
+#include <climits>      // For INT_MIN
+
+// Lays out text once for font; drawing it later with the same font reuses the layout
+static void prepareText(QStaticText &text, const QString &s, const QFont &font)
+{
+    text.setTextFormat(Qt::PlainText);
+    text.setText(s);
+    text.prepare(QTransform(), font);
+}
+
+HudRenderer::HudRenderer()
+    : counterFont("Arial", 16, QFont::Bold),
+      perfFont("Arial", 10),
+      titleFont("Arial", 30, QFont::Bold),
+      hintFont("Arial", 16)
+{
+    counterAscent = QFontMetrics(counterFont).ascent();
+
+    score.label = "Score: ";
+    lives.label = "Lives: ";
+    fireballs.label = "Fireballs: ";
+    for (Counter *c : { &score, &lives, &fireballs }) {
+        c->value = INT_MIN; // laid out on first use
+        c->text.setTextFormat(Qt::PlainText);
+    }
+    perf.setTextFormat(Qt::PlainText);
+
+    // The overlays never change, so they get the heavier caching
+    for (QStaticText *t : { &paused, &gameOver, &restartHint }) {
+        t->setPerformanceHint(QStaticText::AggressiveCaching);
+    }
+    prepareText(paused, "PAUSED", titleFont);
+    prepareText(gameOver, "GAME OVER", titleFont);
+    prepareText(restartHint, "Press Space to Restart", hintFont);
+}
+
+void HudRenderer::setCounter(Counter &counter, int value)
+{
+    if (value == counter.value) return;
+    counter.value = value;
+    counter.text.setText(counter.label + QString::number(value));
+    counter.text.prepare(QTransform(), counterFont);
+}
+
+void HudRenderer::drawCounters(QPainter &painter, int x, int scoreValue, int livesValue, int fireballsValue)
+{
+    setCounter(score, scoreValue);
+    setCounter(lives, livesValue);
+    setCounter(fireballs, fireballsValue);
+
+    painter.setFont(counterFont);
+    painter.drawStaticText(x, 40 - counterAscent, score.text);
+    painter.drawStaticText(x, 70 - counterAscent, lives.text);
+    painter.drawStaticText(x, 100 - counterAscent, fireballs.text);
+}
+
+void HudRenderer::drawPerf(QPainter &painter, const QRect &rect, const QString &text)
+{
+    if (text != perfSource) {
+        perfSource = text;
+        QString lines = text;
+        lines.replace('\n', QChar::LineSeparator); // QStaticText only breaks lines on U+2028
+        perf.setText(lines);
+        perf.prepare(QTransform(), perfFont);
+    }
+    painter.setFont(perfFont);
+    painter.drawStaticText(rect.topLeft(), perf);
+}
+
+void HudRenderer::drawCentered(QPainter &painter, const QPoint &center, const QStaticText &text)
+{
+    QSizeF size = text.size();
+    painter.drawStaticText(QPointF(center.x() - size.width() / 2, center.y() - size.height() / 2), text);
+}
+
+void HudRenderer::drawPaused(QPainter &painter, const QRect &frameRect)
+{
+    painter.setFont(titleFont);
+    drawCentered(painter, frameRect.center(), paused);
+}
+
+void HudRenderer::drawGameOver(QPainter &painter, const QRect &frameRect)
+{
+    painter.setFont(titleFont);
+    drawCentered(painter, frameRect.center(), gameOver);
+    painter.setFont(hintFont);
+    drawCentered(painter, frameRect.center() + QPoint(0, 60), restartHint);
+}
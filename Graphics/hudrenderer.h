@@ -0,0 +1,43 @@
+#ifndef HUDRENDERER_H
+#define HUDRENDERER_H
+
+#include <QPainter>
+#include <QFont>
+#include <QStaticText>
+#include <QString>
+
+// Draws the game's text: Score/Lives/Fireballs, the profiler lines and the
+// PAUSED / GAME OVER overlays. Fonts are built once and every string is a
+// QStaticText laid out ahead of time, so a frame only replays cached
+// glyph runs. A counter is re-laid out when its value changes, never
+// otherwise, and drawing allocates nothing.
+class HudRenderer
+{
+public:
+    HudRenderer();
+
+    // The three counters, left-aligned at x, one line every 30px from baseline 40
+    void drawCounters(QPainter &painter, int x, int score, int lives, int fireballs);
+    void drawPerf(QPainter &painter, const QRect &rect, const QString &text); // Multi-line, top-left of rect
+    void drawPaused(QPainter &painter, const QRect &frameRect);
+    void drawGameOver(QPainter &painter, const QRect &frameRect);
+
+private:
+    struct Counter {
+        QString label; // "Score: "
+        int value;
+        QStaticText text;
+    };
+
+    void setCounter(Counter &counter, int value); // Re-lays out only if value changed
+    void drawCentered(QPainter &painter, const QPoint &center, const QStaticText &text);
+
+    QFont counterFont, perfFont, titleFont, hintFont;
+    int counterAscent; // drawText() took baselines, QStaticText takes top-left corners
+    Counter score, lives, fireballs;
+    QString perfSource; // perfText the layout below was made from
+    QStaticText perf;
+    QStaticText paused, gameOver, restartHint;
+};
+
+#endif // HUDRENDERER_H
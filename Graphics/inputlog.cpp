@@ -0,0 +1,120 @@
+#include "inputlog.h"
+
+#include <QFile>
+#include <QByteArray>
+
+static const char LOG_MAGIC[4] = { 'D', 'I', 'N', 'L' };
+static const quint8 LOG_VERSION = 4; // bumped whenever the rules change, since old logs would replay differently
+
+// --- Varint helpers (7 bits per byte, high bit = more follows) ---
+static void putVarint(QByteArray &out, quint64 v) {
+    while (v >= 0x80) {
+        out.append(char(quint8(v) | 0x80));
+        v >>= 7;
+    }
+    out.append(char(quint8(v)));
+}
+
+static bool getVarint(const QByteArray &in, int &pos, quint64 &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) return false;
+        quint8 b = quint8(in[pos++]);
+        v |= quint64(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+void InputLog::clear() {
+    events.clear();
+    endTick = 0;
+}
+
+bool InputLog::save(const QString &path) const {
+    QByteArray out;
+    out.append(LOG_MAGIC, 4);
+    out.append(char(LOG_VERSION));
+    for (int i = 0; i < 8; ++i) out.append(char(quint8(seed >> (8 * i))));
+    putVarint(out, quint64(frame_width));
+    putVarint(out, quint64(frame_height));
+    putVarint(out, quint64(gap));
+    putVarint(out, events.size());
+
+    quint32 lastTick = 0;
+    for (const Event &e : events) {
+        putVarint(out, e.tick - lastTick); // ticks only ever grow
+        out.append(char(e.keys));
+        lastTick = e.tick;
+    }
+    putVarint(out, endTick - lastTick);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    return file.write(out) == out.size();
+}
+
+bool InputLog::load(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QByteArray in = file.readAll();
+
+    if (in.size() < 13 || !in.startsWith(QByteArray(LOG_MAGIC, 4)) || quint8(in[4]) != LOG_VERSION)
+        return false;
+
+    int pos = 5;
+    quint64 s = 0;
+    for (int i = 0; i < 8; ++i) s |= quint64(quint8(in[pos++])) << (8 * i);
+
+    quint64 w, h, g, count;
+    if (!getVarint(in, pos, w) || !getVarint(in, pos, h) || !getVarint(in, pos, g) || !getVarint(in, pos, count))
+        return false;
+    if (count > quint64(in.size())) return false; // every event takes at least two bytes
+
+    std::vector<Event> loaded;
+    loaded.reserve(count);
+    quint64 tick = 0, delta;
+    for (quint64 i = 0; i < count; ++i) {
+        if (!getVarint(in, pos, delta) || pos >= in.size()) return false;
+        tick += delta;
+        loaded.push_back(Event{quint32(tick), quint8(in[pos++])});
+    }
+    if (!getVarint(in, pos, delta)) return false;
+
+    seed = s;
+    frame_width = int(w);
+    frame_height = int(h);
+    gap = int(g);
+    events.swap(loaded);
+    endTick = quint32(tick + delta);
+    return true;
+}
+
+void InputLog::replay(GameWorld &world) const {
+    size_t e = 0;
+    for (quint32 t = 0; t < endTick; ++t) {
+        replayTick(world, t, e);
+    }
+    for (; e < events.size(); ++e) { // keys after the last step (e.g. a final restart)
+        if (events[e].keys & Restart) world.restartGame();
+        if (events[e].keys & Pause) world.togglePause();
+    }
+}
+
+void InputLog::replayTick(GameWorld &world, quint32 tick, size_t &nextEvent) const {
+    // Same order MainWindow applies things in: keys pressed since the last
+    // tick (restart and pause take effect at once), then one step()
+    GameInputs inputs;
+    for (; nextEvent < events.size() && events[nextEvent].tick == tick; ++nextEvent) {
+        quint8 keys = events[nextEvent].keys;
+        if (keys & Restart) {
+            world.restartGame();
+            inputs = GameInputs(); // MainWindow drops pending keys on restart
+        }
+        if (keys & Pause) world.togglePause();
+        if (keys & Jump) inputs.jump = true;
+        if (keys & Fly) inputs.toggleFly = true;
+        if (keys & Fire) inputs.fire = true;
+    }
+    world.step(inputs);
+}
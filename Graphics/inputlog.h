@@ -0,0 +1,44 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <QString>
+#include <vector>
+#include "gameworld.h"
+
+// Compact recording of one play session: the world's seed and frame setup,
+// plus every key that reached the game, stamped with the number of ticks
+// stepped before it was applied. Replaying it on a fresh GameWorld gives the
+// same run bit for bit, with no window and as fast as the CPU allows.
+//
+// File layout (little endian): "DINL", version byte, seed (8 bytes), then
+// varints: frame width, height, gap, event count, per event (tick delta,
+// key byte), and finally the tick count left after the last event.
+class InputLog
+{
+public:
+    enum Key : quint8 { Jump = 1, Fly = 2, Fire = 4, Pause = 8, Restart = 16 };
+
+    struct Event {
+        quint32 tick; // ticks stepped before the key was applied
+        quint8 keys;  // Key bits
+    };
+
+    quint64 seed = 0;
+    int frame_width = 0, frame_height = 0, gap = 0;
+    std::vector<Event> events; // in the order the keys were pressed
+    quint32 endTick = 0; // total ticks stepped in the session
+
+    void clear();
+    void add(quint32 tick, quint8 keys) { events.push_back(Event{tick, keys}); }
+
+    bool save(const QString &path) const;
+    bool load(const QString &path); // false if the file is missing or not a valid log
+
+    // Steps world (built from seed/frame setup above) through the whole session
+    void replay(GameWorld &world) const;
+    // Same, one tick at a time: applies the keys stamped with tick, then steps.
+    // Call with tick = 0, 1, ... < endTick; nextEvent starts at 0 and is advanced.
+    void replayTick(GameWorld &world, quint32 tick, size_t &nextEvent) const;
+};
+
+#endif // INPUTLOG_H
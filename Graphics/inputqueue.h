@@ -0,0 +1,68 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <QtGlobal>
+#include "gameworld.h"
+#include "inputlog.h"
+
+// Gameplay keys waiting for the tick they belong to. Every key is stamped
+// with the time it arrived, and the fixed-step loop takes the ones pressed
+// before the end of the tick it is about to step. A key therefore lands on
+// the substep that covers the moment it was pressed, not on whichever tick
+// happens to run next, and keys that came in after the last simulated
+// moment wait for the next frame's ticks.
+//
+// A tick takes each key at most once: a second Space within one tick waits
+// for the following tick, so two quick presses still make a double jump.
+// Fixed capacity and no allocation; keys pressed while it is full are lost.
+class InputQueue
+{
+public:
+    static const int Capacity = 32;
+
+    bool push(qint64 time, quint8 key) // key is one InputLog::Key bit; false if full
+    {
+        if (count == Capacity) return false;
+        items[(first + count) % Capacity] = Item{ time, key };
+        count++;
+        return true;
+    }
+
+    // Moves the keys pressed before tickEnd into inputs, oldest first, and
+    // returns their InputLog::Key bits (0 if none); pressedAt gets the time
+    // of the oldest one
+    quint8 take(qint64 tickEnd, GameInputs &inputs, qint64 &pressedAt)
+    {
+        quint8 keys = 0;
+        while (count > 0 && items[first].time < tickEnd && !(keys & items[first].key)) {
+            if (keys == 0) pressedAt = items[first].time;
+            keys |= items[first].key;
+            first = (first + 1) % Capacity;
+            count--;
+        }
+        inputs.jump = keys & InputLog::Jump;
+        inputs.toggleFly = keys & InputLog::Fly;
+        inputs.fire = keys & InputLog::Fire;
+        return keys;
+    }
+
+    void delay(qint64 by) // moves every queued key later, e.g. past a pause
+    {
+        for (int i = 0; i < count; ++i) items[(first + i) % Capacity].time += by;
+    }
+
+    void clear() { first = count = 0; }
+    bool isEmpty() const { return count == 0; }
+
+private:
+    struct Item {
+        qint64 time; // Profiler::now() when the key arrived
+        quint8 key;
+    };
+
+    Item items[Capacity];
+    int first = 0; // oldest key
+    int count = 0;
+};
+
+#endif // INPUTQUEUE_H
@@ -1,11 +1,66 @@
 #include "mainwindow.h"
+#include "backendbench.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QRandomGenerator>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
-    MainWindow w;
+
+    // --seed N replays the same obstacles; --record FILE saves the session
+    // for "soak --replay FILE"; --profile NAME writes NAME.csv and NAME.json
+    // (Chrome trace) frame timings on exit; --threaded paints on a worker thread;
+    // --raster software fills grid cells with the parallel software rasteriser;
+    // --target picks the back buffer format; --style vector draws polygons in
+    // pixel space instead of grid blocks; --compare-backends N renders N
+    // replayed frames with every style/target/raster combination and prints the throughput
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption seedOption("seed", "Seed for the game's random numbers.", "n");
+    QCommandLineOption recordOption("record", "Write an input log of the session to <file> on exit.", "file");
+    QCommandLineOption profileOption("profile", "Write frame timings to <name>.csv and <name>.json on exit.", "name");
+    QCommandLineOption threadedOption("threaded", "Render frames on a separate thread.");
+    QCommandLineOption rasterOption("raster", "How grid cells are filled: painter (default) or software.", "backend", "painter");
+    QCommandLineOption targetOption("target", "Back buffer: pixmap, argb32pm (default), rgb32 or framebuffer.", "kind", "argb32pm");
+    QCommandLineOption styleOption("style", "How the game is drawn: grid (default) or vector.", "style", "grid");
+    QCommandLineOption compareOption("compare-backends", "Render <frames> frames offscreen with every style, back buffer "
+                                     "and raster backend, print frames/s and exit.", "frames");
+    QCommandLineOption replayOption("replay", "With --compare-backends: render this input log instead of a bot session.", "file");
+    parser.addOption(seedOption);
+    parser.addOption(recordOption);
+    parser.addOption(profileOption);
+    parser.addOption(threadedOption);
+    parser.addOption(rasterOption);
+    parser.addOption(targetOption);
+    parser.addOption(styleOption);
+    parser.addOption(compareOption);
+    parser.addOption(replayOption);
+    parser.process(a);
+
+    quint64 seed = parser.isSet(seedOption) ? parser.value(seedOption).toULongLong()
+                                            : QRandomGenerator::global()->generate64();
+
+    if (parser.isSet(compareOption))
+        return runBackendComparison(parser.value(compareOption).toInt(), parser.value(replayOption), seed);
+
+    RenderTarget::Kind target;
+    if (!RenderTarget::kindFromName(parser.value(targetOption), target)) {
+        qWarning("Unknown --target %s", qPrintable(parser.value(targetOption)));
+        return 1;
+    }
+
+    GameRenderer::Style style = GameRenderer::GridStyle;
+    if (parser.value(styleOption) == "vector") {
+        style = GameRenderer::VectorStyle;
+    } else if (parser.value(styleOption) != "grid") {
+        qWarning("Unknown --style %s", qPrintable(parser.value(styleOption)));
+        return 1;
+    }
+
+    MainWindow w(seed, parser.value(recordOption), parser.value(profileOption),
+                 parser.isSet(threadedOption), parser.value(rasterOption) == "software", target, style);
     w.show();
     return a.exec();
 }
@@ -2,99 +2,93 @@
 #include "ui_mainwindow.h"
 
 // Qt includes
-#include <QPixmap>
-#include <QImage>
 #include <QPainter>
 #include <QDebug>       // For printing to console
 #include <QKeyEvent>    // For keyboard input
 #include <QFont>        // For drawing score/text
+#include <QScreen>      // For the display refresh rate
+
+// Fixed-step loop: the world always advances in GameWorld::TICK_MS steps;
+// after a stall it catches up at most this many ticks per frame and then
+// simply drops the rest, instead of falling further and further behind
+static const qint64 TICK_NS = GameWorld::TICK_MS * 1000000LL;
+static const int MAX_SUBSTEPS = 5;
 
 // C++ Standard Library includes
-#include <cstdlib>      // For rand()
-#include <ctime>        // For srand()
 #include <cmath>        // For math functions
 #include <numeric>      // (From original code)
 #include <vector>       // (From original code)
 
-// Define static weapon velocity
-int Weapon::weapon_velocity = 2; // moves rightwards (grid units per frame)
-
-// --- NEW Game Variables (pretend these are in mainwindow.h) ---
-int jumpCount;
-const int maxJumps = 2; // For double jump
-int base_obstacle_speed;
-bool isPaused; // --- NEW for Pause ---
-bool isFlying; // --- NEW for Cheat ---
-
-// --- NEW Staircase Variables ---
-bool staircaseMode;
-bool staircaseTriggered; // To ensure it only happens once per game
-std::vector<QPoint> terrainBlocks; // For stairs
-int staircaseTimer;
-int current_stair_y;
-
-// fire ball
-const int FIREBALL_WIDTH=5;
-bool fireBallsAdded;
-MainWindow::MainWindow(QWidget *parent) :
+MainWindow::MainWindow(quint64 seed, const QString &recordPath, const QString &profilePath, bool threaded,
+                       bool softwareRaster, RenderTarget::Kind target, GameRenderer::Style style, QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::MainWindow) // <-- FIX #1: Was "new Ui_MainWindow"
+    ui(new Ui::MainWindow), // <-- FIX #1: Was "new Ui_MainWindow"
+    lastFrameTime(0),
+    accumulator(0),
+    tickCount(0),
+    recordPath(recordPath),
+    profilePath(profilePath),
+    showPerfHud(false),
+    lastPerfUpdate(0),
+    latencyPending(false),
+    latencyStart(0),
+    latencyTick(0),
+    renderThread(nullptr),
+    renderWorker(nullptr),
+    lastPresented(0),
+    streamThread(nullptr),
+    chunkStreamer(nullptr)
 {
     ui->setupUi(this);
-    frame_width = ui->frame->width();
-    frame_height = ui->frame->height();
+    // Fixed internal resolution: the world and every frame keep this size
+    // whatever the window does, and GameCanvas scales the result to fit
+    frame_width = GameWorld::DEFAULT_WIDTH;
+    frame_height = GameWorld::DEFAULT_HEIGHT;
 
-    // Setup colors
-    fill1 = QColor(35, 176, 106); // Dino
-    obstacleColor = QColor(200, 50, 50); // Obstacle
+    // Setup colors (game colours live in GameRenderer)
     fill2 = QColor(18, 141, 21);
     fill3 = QColor(20, 4, 41);
 
-    // Setup grid size and physics scaled to that size
-    gap = 5;
-    double scale_factor = 20.0 / double(gap);
-    gravity = 0.1 * scale_factor;
-    jump_power = -1.2 * scale_factor; // Shorter jump
-
-    // --- MODIFIED: Speed ---
-    base_obstacle_speed = (int)round(scale_factor); // Store the base speed
-    obstacle_speed = base_obstacle_speed; // Set the current speed
-
     currentDrawingMode = Normal;
 
-    // --- MODIFIED: Define a larger Dino Shape ---
-    dinoShape.clear(); // Clear the old shape first
-    // New, larger shape relative to (0,0) as the front foot
-
-    // Head
-    dinoShape.push_back(QPoint(1, -6));
-    dinoShape.push_back(QPoint(0, -6));
-    dinoShape.push_back(QPoint(1, -5));
-    dinoShape.push_back(QPoint(0, -5));
-    // Neck
-    dinoShape.push_back(QPoint(0, -4));
-    dinoShape.push_back(QPoint(0, -3));
-    // Body
-    dinoShape.push_back(QPoint(-3, -2));
-    dinoShape.push_back(QPoint(-2, -2));
-    dinoShape.push_back(QPoint(-1, -2));
-    dinoShape.push_back(QPoint(0, -2));
-    // Tail/Body
-    dinoShape.push_back(QPoint(-4, -1));
-    dinoShape.push_back(QPoint(-3, -1));
-    dinoShape.push_back(QPoint(-2, -1));
-    dinoShape.push_back(QPoint(-1, -1));
-    // Legs
-    dinoShape.push_back(QPoint(-2, 0)); // Back foot
-    dinoShape.push_back(QPoint(0, 0));  // Front foot
-
-    // Initialize game world variables
-    srand(time(NULL));
-    min_x = to_grid(0, 0).x();
-    max_x = to_grid(frame_width, 0).x();
-    world_width = max_x - min_x;
-    ground_y = to_grid(0, frame_height * 0.75).y();
-    dino_x = min_x + 10;
+    // Setup grid size; physics and the dino shape are scaled inside the world
+    world = new GameWorld(frame_width, frame_height, GameWorld::DEFAULT_GAP, seed);
+    qDebug() << "Seed:" << seed; // quote this (or send the --record file) with bug reports
+
+    inputLog.seed = seed;
+    inputLog.frame_width = frame_width;
+    inputLog.frame_height = frame_height;
+    inputLog.gap = world->gap;
+
+    // Frame-time probes: the world's phases, drawing and the final blit
+    world->profiler = &profiler;
+    ui->frame->setProfiler(&profiler);
+    ui->frame->setTargetKind(target);
+
+    BlockBatcher::Backend backend = softwareRaster ? BlockBatcher::SoftwareBackend : BlockBatcher::PainterBackend;
+    renderer.setBackend(backend);
+    renderer.setStyle(style);
+
+    if (threaded) {
+        // The worker only ever sees copies of the world (FrameSnapshot)
+        renderWorker = new RenderWorker(*world, &profiler);
+        renderWorker->setBackend(backend);
+        renderWorker->setStyle(style);
+        renderThread = new QThread(this);
+        renderWorker->moveToThread(renderThread);
+        connect(renderThread, &QThread::finished, renderWorker, &QObject::deleteLater);
+        connect(renderWorker, &RenderWorker::frameReady, this, &MainWindow::presentRendered);
+        renderThread->start();
+    }
+
+    // Chunks of the world are built ahead of the dino on a worker thread
+    chunkStreamer = new ChunkStreamer(world->worldConfig);
+    streamThread = new QThread(this);
+    chunkStreamer->moveToThread(streamThread);
+    connect(streamThread, &QThread::started, chunkStreamer, &ChunkStreamer::start);
+    connect(streamThread, &QThread::finished, chunkStreamer, &QObject::deleteLater);
+    world->chunkSource = chunkStreamer;
+    streamThread->start();
 
     // Connect original app signals
     connect(ui->frame, SIGNAL(Mouse_Pos()), this, SLOT(Mouse_Pressed()));
@@ -102,17 +96,32 @@ MainWindow::MainWindow(QWidget *parent) :
 
     // CRITICAL: Create the timer *before* calling restartGame()
     gameTimer = new QTimer(this);
+    gameTimer->setTimerType(Qt::PreciseTimer);
     connect(gameTimer, &QTimer::timeout, this, &MainWindow::gameLoop);
 
     // Set up the game to be on the "Game Over" screen
-    restartGame(); // Set default values
-    isGameOver = true; // Override to start in this mode
-    gameTimer->stop(); // Stop the timer
+    world->isGameOver = true; // Start in this mode until Space is pressed
 
     drawGame(); // Draw the initial "Press Space" screen
 }
 
 MainWindow::~MainWindow(){
+    world->chunkSource = nullptr;
+    streamThread->quit(); // the streamer is deleted when the thread finishes
+    streamThread->wait();
+    if (renderThread) {
+        renderThread->quit(); // the worker is deleted when the thread finishes
+        renderThread->wait();
+    }
+    if (!recordPath.isEmpty()) {
+        inputLog.endTick = tickCount;
+        if (!inputLog.save(recordPath)) qWarning() << "Could not write input log to" << recordPath;
+    }
+    if (!profilePath.isEmpty()) {
+        if (!profiler.writeCsv(profilePath + ".csv") || !profiler.writeChromeTrace(profilePath + ".json"))
+            qWarning() << "Could not write profile to" << profilePath;
+    }
+    delete world;
     delete ui;
 }
 
@@ -124,92 +133,6 @@ void MainWindow::showMousePosition(QPoint &pos) {
 }
 
 
-// --- Grid Helper Functions ---
-QPoint MainWindow::to_grid(int curr_x, int curr_y){
-    double rel_x = curr_x - frame_width/2, rel_y = curr_y - frame_height/2;
-    rel_x /= (double)gap, rel_y /= (double)gap;
-    return QPoint((int)round(rel_x), (int)round(rel_y));
-}
-
-QPoint MainWindow::from_grid(int grid_x, int grid_y) {
-    double rel_x = grid_x * gap;
-    double rel_y = grid_y * gap;
-
-    int curr_x = rel_x + frame_width/2;
-    int curr_y = rel_y + frame_height/2;
-
-    return QPoint(curr_x, curr_y);
-}
-
-// Draws a single block to a painter (flicker-free)
-void MainWindow::draw_grid_box(QPainter &painter, int x, int y, QColor c) {
-    QPoint mid = from_grid(x, y);
-    int mid_x = mid.x(), mid_y = mid.y();
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(c);
-    QRect rect(mid_x-gap/2, mid_y-gap/2, gap, gap);
-    painter.drawRect(rect);
-}
-
-// Draws the background grid (currently not called)
-void MainWindow::draw_grid(QPainter &painter){
-    painter.setPen(QPen(Qt::black, 1));
-    int centerX = frame_width / 2;
-    int centerY = frame_height / 2;
-    for(int i = centerX; i <= frame_width; i += gap)
-        painter.drawLine(QPoint(i, 0), QPoint(i, frame_height));
-    for(int i = centerX - gap; i >= 0; i -= gap)
-        painter.drawLine(QPoint(i, 0), QPoint(i, frame_height));
-    for(int i = centerY; i <= frame_height; i += gap)
-        painter.drawLine(QPoint(0, i), QPoint(frame_width, i));
-    for(int i = centerY - gap; i >= 0; i -= gap)
-        painter.drawLine(QPoint(0, i), QPoint(frame_width, i));
-}
-
-// --- NEW: Draw Terrain Blocks (Stairs) updated in drawGame() ---
-void MainWindow::updateStaircase() {
-    staircaseTimer++;
-
-    // 1. Move existing blocks left
-    for (size_t i = 0; i < terrainBlocks.size(); ++i) {
-        terrainBlocks[i].setX(terrainBlocks[i].x() - obstacle_speed);
-        if (terrainBlocks[i].x() < min_x - 5) {
-            terrainBlocks.erase(terrainBlocks.begin() + i);
-            i--;
-        }
-    }
-
-    // 2. Define phases by timer
-    int rising_duration = 100; // 100 frames of rising
-    int flat_duration = 300;   // 300 frames of flat
-    int falling_duration = 100; // 100 frames of falling
-    int step_rate = 10; // New block every 10 frames
-
-    // 3. Spawn new blocks based on phase
-    if (staircaseTimer % step_rate == 0) {
-        if (staircaseTimer < rising_duration) {
-            // Phase 1: Rising
-            current_stair_y--;
-            terrainBlocks.push_back(QPoint(max_x, current_stair_y));
-        } else if (staircaseTimer < rising_duration + flat_duration) {
-            // Phase 2: Flat
-            terrainBlocks.push_back(QPoint(max_x, current_stair_y));
-        } else if (staircaseTimer < rising_duration + flat_duration + falling_duration) {
-            // Phase 3: Falling
-            current_stair_y++;
-            terrainBlocks.push_back(QPoint(max_x, current_stair_y));
-        }
-    }
-
-    // 4. End staircase mode after it's finished and all blocks are gone
-    if (staircaseTimer >= rising_duration + flat_duration + falling_duration) {
-        if (terrainBlocks.empty()) { // Wait for last block to disappear
-            staircaseMode = false;
-        }
-    }
-}
-
-
 // --- Game Functions ---
 
 void MainWindow::on_clear_clicked(){
@@ -220,532 +143,240 @@ void MainWindow::on_clear_clicked(){
 
 void MainWindow::keyPressEvent(QKeyEvent *event) {
     // --- MODIFIED: Pause, Fly, and Jump logic ---
+    // Gameplay keys go into inputQueue with the time they arrived, and
+    // gameLoop() applies each one on the tick that covers that time.
+    // (QKeyEvent::timestamp() is on the window system's clock, which the
+    // loop cannot compare with, so the key is stamped here instead.)
+    qint64 pressedAt = profiler.now();
+
+    // --- NEW: Holding a key must not jump, fire or toggle again ---
+    if (event->isAutoRepeat()) return;
 
     // Always allow pause/unpause, even on game over screen
     if (event->key() == Qt::Key_P) {
-        if (!isGameOver) {
-            isPaused = !isPaused;
-            if (isPaused) {
+        if (!world->isGameOver) {
+            recordKey(InputLog::Pause);
+            world->togglePause();
+            if (world->isPaused) {
                 gameTimer->stop();
                 drawGame(); // Redraw to show "PAUSED" text
+                latencyPending = false; // a key still waiting for its frame would be timed across the pause
             } else {
-                gameTimer->start(33);
+                startLoop();
             }
         }
         return;
     }
 
+    // Fullscreen on and off; the frame is just scaled, the game is unaffected
+    if (event->key() == Qt::Key_F11) {
+        if (isFullScreen()) {
+            showNormal();
+        } else {
+            showFullScreen();
+        }
+        menuBar()->setVisible(!isFullScreen());
+        statusBar()->setVisible(!isFullScreen());
+        return;
+    }
+
+    // Debug overlay: outline the dirty rectangles each frame repaints
+    if (event->key() == Qt::Key_F3) {
+        ui->frame->setShowDirtyRects(!ui->frame->showDirtyRects());
+        return;
+    }
+
+    // Profiler HUD: frame time percentiles and FPS under the score
+    if (event->key() == Qt::Key_F2) {
+        showPerfHud = !showPerfHud;
+        lastPerfUpdate = 0;
+        updatePerfHud();
+        drawGame();
+        return;
+    }
+
     // Don't process other keys if paused
-    if (isPaused) return;
+    if (world->isPaused) return;
 
     // Handle Space key
     if (event->key() == Qt::Key_Space) {
-        if (isGameOver) {
+        if (world->isGameOver) {
             restartGame(); // Start a new game if it's over
             return;
         }
-
-        if (isFlying) { // If flying, Space moves dino up
-            dino_y_velocity = jump_power * 0.5; // Gentle boost up
-        }
-        else if (jumpCount < maxJumps) { // Allow double jump
-            jumpCount++;
-            isJumping = true; // Ensure gravity takes effect
-            dino_y_velocity = jump_power; // Apply jump boost
-        }
+        inputQueue.push(pressedAt, InputLog::Jump);
     }
 
     // Handle Fly Cheat
     if (event->key() == Qt::Key_F) {
-        if (!isGameOver) {
-            isFlying = !isFlying;
-            if (isFlying) {
-                isJumping = false; // Disable normal jump/gravity logic
-                dino_y_velocity = 0; // Stop falling
-            } else {
-                isJumping = true; // Re-enable gravity
-            }
-            fireballCount=99;
+        if (!world->isGameOver) {
+            inputQueue.push(pressedAt, InputLog::Fly);
         }
     }
 
     // --- NEW: Weapon spawn on Enter/Return ---
     if (event->key() == Qt::Key_Return || event->key() == Qt::Key_Enter) {
-        if (!isGameOver && !isPaused) {
-            spawnWeapon();
+        if (!world->isGameOver) {
+            inputQueue.push(pressedAt, InputLog::Fire);
         }
     }
 }
 
-void MainWindow::gameLoop() {
-    // --- MODIFIED: Added Pause check ---
-    if (isGameOver || isPaused) return; // Don't run logic if game is over or paused
-
-    // Run all game logic
-    if (staircaseMode) updateStaircase(); // --- NEW ---
-    updateDino();
-
-    updateWeapons(); // --- NEW: Update weapons before obstacles ---
-    updateObstacles();
-    checkAndHandleCollision();
-
-    if (isInvincible) { // Tick down invincibility frames
-        invincibilityTimer--;
-        if (invincibilityTimer <= 0) {
-            isInvincible = false;
-        }
-    }
-    // parallax offsets (grid units) with wrap-around
-    mountain1Offset -= mountain1Speed;
-    mountain2Offset -= mountain2Speed;
-
-    if (mountain1Offset <= -world_width) mountain1Offset += world_width;
-    if (mountain2Offset <= -world_width) mountain2Offset += world_width;
-
-    if(score%15==0){
-        haveShield=true;
-    }
-    drawGame(); // Redraw the screen
-
-    if (lives <= 0 && !isGameOver) { // Check for game over condition
-        gameOver();
-    }
+void MainWindow::startLoop() {
+    // One frame per display refresh (60/120/144 Hz...); the simulation rate does not depend on it
+    double hz = screen() ? screen()->refreshRate() : 60.0;
+    gameTimer->start(qMax(1, qRound(1000.0 / (hz > 0 ? hz : 60.0))));
+    // Time spent stopped is not simulated; keys still queued from before the
+    // pause skip it too, so they keep their place between ticks and their
+    // latency samples do not include it
+    qint64 now = profiler.now();
+    inputQueue.delay(now - lastFrameTime);
+    lastFrameTime = now;
 }
 
-void MainWindow::drawGame() {
-    QPixmap pm(frame_width, frame_height);
-    pm.fill(Qt::white);
-    QPainter painter(&pm);
-
-    // draw_grid(painter); // Grid is removed
-    DrawBackground(painter);
-    // Draw Ground
-    for (int x = min_x; x <= max_x; ++x) {
-        draw_grid_box(painter, x, ground_y, QColor(0, 0, 0));
-    }
-
-    // Draw Dino (with invincibility flicker)
-
-    if (!isInvincible || (isInvincible && (invincibilityTimer % 10 < 5))) {
-        for (const QPoint& part : dinoShape) {
-            draw_grid_box(painter, dino_x + part.x(), dino_y + part.y(), fill1);
-        }
-    }
-    if(haveShield){
-        drawShield(painter);
-    }
-        // Draw Obstacles (skip destroyed)
-    for (const Obstacle& ob : obstacles) {
-        if (ob.destroyed) continue; // don't draw destroyed obstacles
-        for (int i = 0; i < ob.height; ++i) {
-            draw_grid_box(painter, ob.x, ground_y - 1 - i, obstacleColor);
-        }
-    }
-
-    // --- NEW: Draw Terrain Blocks (Stairs) ---
-    for (const QPoint& block : terrainBlocks) {
-        draw_grid_box(painter, block.x(), block.y(), QColor(100,100,100)); // Grey
-    }
-
-    // --- NEW: Draw Weapons ---
-    for (const Weapon &w : weapons) {
-        if (w.used) continue;
-        // Visually make it look like a fireball (orange)
-        draw_grid_box(painter, w.x, w.y, QColor(255,140,0));
-        draw_grid_box(painter, w.x+1, w.y, QColor(255,165,0));
-        draw_grid_box(painter, w.x+2, w.y, QColor(255,165,0));
-        draw_grid_box(painter, w.x+3, w.y, QColor(255,165,0));
-    }
-
-    // Draw UI (Score & Lives & Fireballs)
-    painter.setPen(Qt::black);
-    painter.setFont(QFont("Arial", 16, QFont::Bold));
-    painter.drawText(frame_width - 170, 40, QString("Score: %1").arg(score));
-    painter.drawText(frame_width - 170, 70, QString("Lives: %1").arg(lives));
-    painter.drawText(frame_width - 170, 100, QString("Fireballs: %1").arg(fireballCount));
-
-    // --- NEW: Draw Paused Screen ---
-    if (isPaused) {
-        painter.setBrush(QColor(0,0,0,150)); // Semi-transparent black overlay
-        painter.drawRect(rect());
-
-        painter.setPen(Qt::white);
-        painter.setFont(QFont("Arial", 30, QFont::Bold));
-        painter.drawText(rect(), Qt::AlignCenter, "PAUSED");
-    }
-
-    // Draw Game Over Screen
-    if (isGameOver) {
-        painter.setBrush(QColor(0,0,0,150)); // Semi-transparent black overlay
-        painter.drawRect(rect());
-
-        painter.setPen(Qt::white);
-        painter.setFont(QFont("Arial", 30, QFont::Bold));
-        painter.drawText(rect(), Qt::AlignCenter, "GAME OVER");
-
-        painter.setFont(QFont("Arial", 16));
-        painter.drawText(rect().translated(0, 60), Qt::AlignCenter, "Press Space to Restart");
-    }
-
-    painter.end();
-    ui->frame->setPixmap(pm);
-}
-
-// --- Game Logic ---
-
-void MainWindow::updateDino() {
-    // --- MODIFIED: Fly Cheat Logic ---
-    if (isFlying) {
-        // While flying, gravity is OFF.
-        // We apply a little "air friction" so you don't
-        // drift forever after tapping Space.
-        dino_y_velocity *= 0.9; // Instead of adding gravity, we add drag.
-
-        dino_y += dino_y_velocity;
-
-        // Don't let dino fly off the top
-        if (dino_y < to_grid(0,0).y() + 5) {
-            dino_y = to_grid(0,0).y() + 5;
-            dino_y_velocity = 0;
-        }
-
-        // Don't let dino fall through floor
-        if (dino_y >= ground_y - 1) {
-            dino_y = ground_y - 1;
-            dino_y_velocity = 0;
-        }
-        return; // Skip normal jump logic
-    }
-
-    // Normal jump logic
-    if (isJumping) {
-        dino_y_velocity += gravity;
-        dino_y += dino_y_velocity;
-
-        // --- MODIFIED: New Landing Check ---
-        int landing_y = ground_y - 1; // Default to ground
-        bool onTerrain = false;
-
-        // Check for landing on terrain blocks (only if falling)
-        if (dino_y_velocity > 0) {
-            for (const QPoint& block : terrainBlocks) {
-                // Check if a block is right under the dino's feet
-                // (dino_x-2, dino_x-1, dino_x) are the main X coords for feet
-                if ( (block.x() == dino_x || block.x() == dino_x - 1 || block.x() == dino_x - 2) ) {
-                    // This block is in the dino's X-path.
-                    // Is it a valid landing spot? (i.e., we are about to pass it)
-                    if (dino_y >= (block.y() - 1) && (dino_y - dino_y_velocity) < (block.y() - 1)) {
-                        landing_y = block.y() - 1; // New "ground" is 1 block above terrain
-                        onTerrain = true;
-                        break; // Found our landing spot
-                    }
-                }
+void MainWindow::gameLoop() {
+    // --- MODIFIED: Added Pause check ---
+    if (world->isGameOver || world->isPaused) return; // Don't run logic if game is over or paused
+
+    ProfileScope frameProbe(&profiler, Profiler::Frame);
+    qint64 now = profiler.now();
+    accumulator += now - lastFrameTime;
+    lastFrameTime = now;
+
+    // Run as many fixed ticks as real time says are due
+    int substeps = 0;
+    quint64 allocations = 0;
+    while (accumulator >= TICK_NS && substeps < MAX_SUBSTEPS && !world->isGameOver) {
+        // This tick simulates up to tickEnd, so it gets the keys pressed before then
+        qint64 tickEnd = now - accumulator + TICK_NS;
+        GameInputs inputs;
+        qint64 pressedAt = 0;
+        quint8 keys = inputQueue.take(tickEnd, inputs, pressedAt);
+        if (keys) {
+            recordKey(keys);
+            if (!latencyPending) {
+                latencyPending = true;
+                latencyStart = pressedAt;
+                latencyTick = tickCount + 1;
             }
         }
 
-        if (dino_y >= landing_y) { // Check for landing
-            dino_y = landing_y;
-            isJumping = false;
-            dino_y_velocity = 0;
-            jumpCount = 0;
-        }
+        quint64 allocationsBefore = AllocationCounter::count(); // the input log may grow; only step() counts
+        world->step(inputs);
+        allocations += AllocationCounter::count() - allocationsBefore;
+        tickCount++;
+        accumulator -= TICK_NS;
+        substeps++;
     }
-}
-
-void MainWindow::updateObstacles() {
-    // --- NEW: Stop spawning regular obstacles during staircase ---
-    if (staircaseMode) {
-        obstacle_spawn_timer = 0;
+    if (substeps > 0) {
+        profiler.recordAllocations(allocations); // 0 once the pools are warm
     }
-
-    // FIX #3: Use size_t for loop to prevent signed/unsigned warning
-    for (size_t i = 0; i < obstacles.size(); ++i) {
-        // If obstacle is destroyed, still move it left so it goes off-screen
-        obstacles[i].x -= obstacle_speed; // Move obstacle left
-
-        if (!obstacles[i].destroyed && !obstacles[i].passed && obstacles[i].x < dino_x) { // Check for scoring
-            obstacles[i].passed = true;
-            score++;
-
-            // --- NEW: Increase speed on score milestones ---
-            if (score > 0 && score % 25 == 0) {
-                obstacle_speed = base_obstacle_speed + (score / 25);
-                qDebug() << "Speed Increased! New speed:" << obstacle_speed;
-            }
-
-            // --- NEW: Trigger staircase event ---
-            if (score == 100 && !staircaseTriggered) {
-                staircaseMode = true;
-                staircaseTriggered = true; // Only happens once
-                staircaseTimer = 0;
-                current_stair_y = ground_y;
-                qDebug() << "STAIRCASE MODE ACTIVATED!";
-            }
-        }
-
-        if (obstacles[i].x < min_x - 5) { // Remove if off-screen
-            obstacles.erase(obstacles.begin() + i);
-            i--; // Decrement i because we just removed an element
-        }
+    if (accumulator >= TICK_NS && substeps == MAX_SUBSTEPS) {
+        accumulator %= TICK_NS; // too far behind: slow down rather than spiral
     }
 
-    // Check if it's time to spawn a new one
-    obstacle_spawn_timer++;
+    // Redraw the screen part way between the last two ticks
+    updatePerfHud();
+    drawGame(double(accumulator) / TICK_NS);
 
-    // --- MODIFIED: Decreased obstacle gap ---
-    int min_separation = 25; // Was 40
-    int random_separation = 20; // Was 30
-
-    if (obstacle_spawn_timer > (min_separation + (rand() % random_separation))) {
-        spawnObstacle();
-        obstacle_spawn_timer = 0;
+    if (world->isGameOver) { // The world flags game over when lives run out
+        gameOver();
     }
 }
 
-void MainWindow::spawnObstacle() {
-    // --- NEW: Don't spawn if in staircase mode ---
-    if (staircaseMode) return;
-
-    // --- MODIFIED: Taller obstacles and multi-spawn logic ---
-
-    // 1-in-4 chance for a multi-spawn (3 or 4 obstacles)
-    if (score > 50 && (rand() % 4 == 0)) {
-        int totalObstacles = 3 + (rand() % 2); // 3 or 4
-        for (int i = 0; i < totalObstacles; ++i) {
-            int height = (rand() % 3) + 2; // 2, 3, or 4 blocks high (doubled from 1-2)
-            int x_pos = max_x + (i * (8 + (rand() % 4))); // Stagger them 8, 16, 24...
-            obstacles.push_back(Obstacle{x_pos, height, false, false});
-        }
-    }
-    else { // Normal single spawn
-        int height = (rand() % 4) + 4; // 4, 5, 6, or 7 blocks high (doubled from 2-4)
-        obstacles.push_back(Obstacle{max_x, height, false, false}); // Spawn at right edge
+void MainWindow::drawGame(double alpha) {
+    if (renderWorker) {
+        // Hand the worker an immutable copy and get straight back to input and simulation
+        FrameSnapshot &snapshot = renderWorker->snapshots.back();
+        snapshot.world = *world; // vectors keep their capacity, so no allocation in steady state
+        snapshot.alpha = alpha;
+        snapshot.perfText = perfHudText;
+        snapshot.ticks = tickCount;
+        renderWorker->snapshots.publish();
+        QMetaObject::invokeMethod(renderWorker, "renderLatest", Qt::QueuedConnection);
+        return;
     }
-}
 
-void MainWindow::checkAndHandleCollision() {
-    if (isInvincible) return; // Can't be hit if invincible
-
-    for (const QPoint& part : dinoShape) { // Check each block of the dino
-        int dino_part_x = dino_x + part.x();
-        int dino_part_y = dino_y + part.y();
-
-        // --- NEW: Check for collision with terrain ---
-        if (staircaseMode) {
-            for (const QPoint& block : terrainBlocks) {
-                if (dino_part_x == block.x() && dino_part_y == block.y()) {
-                    // Direct collision with a stair block
-                    lives--;
-                    isInvincible = true;
-                    invincibilityTimer = 50;
-                    qDebug() << "Hit a stair block!";
-                    return; // Only one hit
-                }
-            }
-        }
-
-        // FIX #3: Use size_t for loop to prevent signed/unsigned warning
-        for (size_t i = 0; i < obstacles.size(); ++i) { // Against each obstacle
-            const Obstacle& ob = obstacles[i];
-
-            if (ob.destroyed) continue; // ignore destroyed obstacles
-
-            if (dino_part_x >= ob.x && dino_part_x < (ob.x + obstacle_speed)) { // X-axis overlap
-                int ob_top_y = ground_y - ob.height;
-                int ob_bottom_y = ground_y - 1;
-
-                if (dino_part_y >= ob_top_y && dino_part_y <= ob_bottom_y) { // Y-axis overlap
-                    // --- COLLISION! ---
-                    isInvincible = true;
-                    invincibilityTimer = 50;
-                    if(haveShield){
-                        haveShield=false;
-                        score++;
-                        continue;
-                    }
-                    lives--;
-                    isInvincible = true;
-                    invincibilityTimer = 50; // Set invincibility frames
-                    // mark obstacle removed/destroyed
-                    // (we erase it here to avoid double-collisions)
-                    obstacles.erase(obstacles.begin() + i);
-                    return; // Only handle one hit per frame
-                }
-            }
-        }
+    // Draw straight into the canvas' persistent back buffer; no per-frame
+    // QPixmap allocation and no setPixmap() copy
+    QPainter painter(&ui->frame->backBuffer(QSize(frame_width, frame_height)));
+    QRegion dirty;
+    {
+        ProfileScope probe(&profiler, Profiler::Draw);
+        renderer.setPerfText(perfHudText);
+        dirty = renderer.drawGame(painter, *world, alpha); // only what changed is repainted
     }
+    painter.end();
+    ui->frame->present(dirty);
+    reportInputLatency(tickCount);
 }
 
-void MainWindow::DrawBackground(QPainter&painter){
-    // --- BACKGROUND: Sky ---
-    painter.fillRect(0, 0, frame_width, frame_height, QColor(135, 206, 235)); // light blue sky
-
-    // ---- STATIC SUN (grid) ----
-    for (int dx = -sunRadiusGrid; dx <= sunRadiusGrid; ++dx) {
-        for (int dy = -sunRadiusGrid; dy <= sunRadiusGrid; ++dy) {
-            if (dx*dx + dy*dy <= sunRadiusGrid*sunRadiusGrid) {
-                draw_grid_box(painter, sunGridX + dx, sunGridY + dy, QColor(255, 210, 0));
-            }
-        }
+void MainWindow::presentRendered() {
+    if (!renderWorker->frames.update()) return; // already showing the newest frame
+    RenderedFrame &frame = renderWorker->frames.front();
+    profiler.record(Profiler::Draw, frame.drawStart, frame.drawEnd);
+
+    // The canvas holds the frame we presented last; if the worker finished
+    // frames we never picked up, their changes are missing, so copy everything
+    QRegion region = (frame.serial == lastPresented + 1) ? frame.dirty : QRegion(frame.image.rect());
+    QPainter painter(&ui->frame->backBuffer(frame.image.size()));
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect &r : region) {
+        painter.drawImage(r, frame.image, r);
     }
-
-    // ---- FUNCTION: draw a triangular mountain layer (grid units) ----
-    auto drawMountainLayer = [&](int layerOffsetGrid, int peakHeightGrid, double peakFrac, QColor color){
-        int halfWidth = world_width / 2;               // how wide the mountain tile is (grid)
-        int baseY = ground_y;                          // ground line in grid coords
-        // draw two tiles so they seamlessly tile horizontally
-        for (int tile = 0; tile <= 1; ++tile) {
-            // peak X in grid coords (center fraction across world) + offset + tile*world_width
-            int peakX = min_x + int(peakFrac * world_width) + layerOffsetGrid + tile * world_width;
-            // for each column in the tile, compute triangular height
-            for (int x = peakX - halfWidth; x <= peakX + halfWidth; ++x) {
-                int dist = std::abs(x - peakX);
-                // linear falloff from peak to edges
-                int h = peakHeightGrid - (dist * peakHeightGrid) / halfWidth;
-                if (h <= 0) continue;
-                // draw vertical column of 'h' blocks
-                for (int yy = 0; yy < h; ++yy) {
-                    draw_grid_box(painter, x, baseY - 1 - yy, color);
-                }
-            }
-        }
-    };
-    // far layer: subtle, taller peaks, slower movement
-    drawMountainLayer(mountain1Offset, mountain1PeakHeight, 0.35, QColor(120,140,160));
-    // near layer: stronger color, lower peaks, moves a bit faster
-    drawMountainLayer(mountain2Offset, mountain2PeakHeight, 0.6, QColor(95,120,100));
+    painter.end();
+    lastPresented = frame.serial;
+    ui->frame->present(region);
+    reportInputLatency(frame.ticks);
 }
+
 void MainWindow::gameOver() {
     gameTimer->stop(); // Stop the game
-    isGameOver = true;
-    qDebug() << "GAME OVER! Final Score:" << score;
     drawGame(); // Draw the final "Game Over" text
 }
 
 void MainWindow::restartGame() {
-    // Reset all game variables to their default state
-    score = 0;
-    lives = 3;
-    isGameOver = false;
-    isInvincible = false;
-    invincibilityTimer = 0;
-    isPaused = false; // --- NEW ---
-    isFlying = false; // --- NEW ---
-
-    obstacles.clear();
-    terrainBlocks.clear(); // --- NEW ---
-    staircaseMode = false; // --- NEW ---
-    staircaseTriggered = false; // --- NEW ---
-    staircaseTimer = 0; // --- NEW ---
-
-    dino_y = ground_y - 1;
-    dino_y_velocity = 0;
-    isJumping = false;
-    jumpCount = 0; // --- NEW: Reset jump count ---
-    obstacle_spawn_timer = 0;
-    obstacle_speed = base_obstacle_speed; // --- NEW: Reset speed ---
-
-    weapons.clear();
-    fireballCount = 3; // give player 3 fireballs at start
-    // parallax init (in grid units)
-    mountain1Offset = 0;
-    mountain2Offset = 0;
-    mountain1Speed = std::max(1, obstacle_speed / 2);
-    mountain2Speed = std::max(1, obstacle_speed);
-
-    // peak heights (tweak if needed)
-    mountain1PeakHeight = 18;
-    mountain2PeakHeight = 12;
-
-    // static sun position in grid coordinates (relative to world)
-    sunGridX = min_x + world_width / 4;
-    sunGridY = ground_y - 18;
-    sunRadiusGrid = 6;
-
-    gameTimer->start(33); // Start the game loop
+    recordKey(InputLog::Restart); // Space on the game over screen, or the clear button
+    world->restartGame(); // Reset all game variables to their default state
+    inputQueue.clear();
+    latencyPending = false;
+    accumulator = 0;
+    startLoop(); // Start the game loop
 }
 
-// --- NEW: Weapon handling ---
-void MainWindow::spawnWeapon() {
-    if (fireballCount <= 0) return; // no ammo
-
-    // spawn at dino's head height (we'll use dino_y as "base" height)
-    Weapon w;
-    w.x = dino_x + 2; // a bit in front of the dino
-    w.y = dino_y - 3;     // same height as the dino's reference point (front foot)
-    w.used = false;
-    weapons.push_back(w);
-    fireballCount--;
-    qDebug() << "Fired! Remaining:" << fireballCount;
+void MainWindow::recordKey(quint8 keys) {
+    inputLog.add(tickCount, keys);
 }
 
-void MainWindow::updateWeapons() {
-    // move weapons and check collisions
-    if(score%10==0){
-        if(!fireBallsAdded){
-            fireballCount+=3;
-        }
-        fireBallsAdded = true;
+void MainWindow::updatePerfHud() {
+    if (!showPerfHud) {
+        perfHudText.clear();
+        return;
     }
-    else {fireBallsAdded=false;}
-    for (size_t i = 0; i < weapons.size(); ++i) {
-        if (weapons[i].used) continue;
-
-        weapons[i].x += Weapon::weapon_velocity; // move rightwards
-
-        // if off-screen, mark used
-        if (weapons[i].x > max_x + 5) {
-            weapons[i].used = true;
-            continue;
-        }
-
-        // check collision with obstacles
-        for (size_t j = 0; j < obstacles.size(); ++j) {
-            if (obstacles[j].destroyed) continue;
-
-            // approximate width for obstacle as 3 grid unit
-            if (weapons[i].x >= obstacles[j].x && weapons[i].x <= obstacles[j].x + FIREBALL_WIDTH) {
-                int ob_top_y = ground_y - obstacles[j].height;
-                int ob_bottom_y = ground_y - 1;
-
-                if (weapons[i].y >= ob_top_y && weapons[i].y <= ob_bottom_y) {
-                    // hit!
-                    obstacles[j].destroyed = true; // set destroyed boolean as requested
-                    obstacles[j].passed = true; // so it won't increment score later
-                    this->score++;
-                    weapons[i].used = true;
-                    qDebug() << "Weapon hit obstacle at index" << j << "-> destroyed";
-                    break; // weapon consumed
-                }
-            }
-        }
-    }
-
-    // remove used/offscreen weapons to keep vector small
-    for (size_t i = 0; i < weapons.size(); ++i) {
-        if (weapons[i].used) {
-            weapons.erase(weapons.begin() + i);
-            i--;
-        }
+    // Changing text means repainting its rect, so only a few times a second
+    qint64 now = profiler.now();
+    if (lastPerfUpdate != 0 && now - lastPerfUpdate < 250000000LL) return;
+    lastPerfUpdate = now;
+
+    Profiler::Stats frame = profiler.stats(Profiler::Frame);
+    Profiler::Stats draw = profiler.stats(Profiler::Draw);
+    Profiler::Stats input = profiler.stats(Profiler::Input);
+    perfHudText = QString("frame p50 %1 / p99 %2 ms\ndraw p50 %3 / p99 %4 ms\ninput p50 %5 / p99 %6 ms\nFPS %7")
+                      .arg(frame.p50, 0, 'f', 2).arg(frame.p99, 0, 'f', 2)
+                      .arg(draw.p50, 0, 'f', 2).arg(draw.p99, 0, 'f', 2)
+                      .arg(input.p50, 0, 'f', 1).arg(input.p99, 0, 'f', 1)
+                      .arg(profiler.fps(), 0, 'f', 0);
+    if (AllocationCounter::isEnabled()) { // CONFIG += count_allocations
+        // Without malloc() counted (not glibc) it is only operator new
+        perfHudText += QString(AllocationCounter::countsMalloc() ? "\ntick allocs max %1" : "\ntick new() max %1")
+                           .arg(profiler.maxAllocations());
     }
 }
 
-// Draws a circular shield around the dino using its current position
-void MainWindow::drawShield(QPainter &painter, int radiusGrid, QColor color)
-{
-    int centerX = dino_x;      // dino's current X position
-    int centerY = dino_y - 3;  // slightly above feet, roughly center of body
-
-    for (int dx = -radiusGrid; dx <= radiusGrid; ++dx) {
-        for (int dy = -radiusGrid; dy <= radiusGrid; ++dy) {
-            int distSq = dx * dx + dy * dy;
-            int rSq = radiusGrid * radiusGrid;
-            // only draw near the outer edge to form a circle outline
-            if (distSq >= rSq - radiusGrid && distSq <= rSq + radiusGrid) {
-                draw_grid_box(painter, centerX + dx, centerY + dy, color);
-            }
-        }
-    }
+void MainWindow::reportInputLatency(quint32 ticksShown) {
+    // Times the first key applied since the last sample, from its press
+    // until the first frame that includes its tick reaches the canvas
+    if (!latencyPending || ticksShown < latencyTick) return;
+    profiler.record(Profiler::Input, latencyStart, profiler.now());
+    latencyPending = false;
 }
-
-
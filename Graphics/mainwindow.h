@@ -11,6 +11,16 @@
 #include <cmath>
 #include <QTimer>     // Required for game loop
 #include <QKeyEvent>  // Required for keyboard input
+#include "gameworld.h" // Simulation state and rules
+#include "gamerenderer.h" // Draws the world
+#include "inputlog.h" // Records keys for replays
+#include "inputqueue.h" // Timestamped keys waiting for their tick
+#include "profiler.h" // Frame-time probes
+#include "allocationcounter.h" // Heap allocations per tick, if built in
+#include "renderworker.h" // Optional render thread
+#include "chunkstreamer.h" // World chunks built ahead on their own thread
+#include "rendertarget.h" // Back buffer formats
+#include <QThread>
 
 // Forward declaration
 QT_BEGIN_NAMESPACE
@@ -23,29 +33,21 @@ struct point_info {
     QColor c;
 };
 
-// Struct to hold all data for an obstacle
-struct Obstacle {
-    int x;
-    int height;
-    bool passed; // For score tracking
-    bool destroyed;
-    Obstacle(int x,int height,bool passed,bool destroyed):x(x),height(height),passed(passed),destroyed(destroyed){}
-};
-
-// Weapon struct for fireball / dragon-ball
-struct Weapon{
-    static int weapon_velocity; // define in cpp
-    int x;      // x position in grid coords
-    int y;      // y position in grid coords (height)
-    bool used;  // true when it hit something or went off-screen
-};
-
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    MainWindow(QWidget *parent = nullptr);
+    // seed picks the run; if recordPath is set the session is saved there on exit,
+    // and if profilePath is set the frame timings go to profilePath.csv/.json.
+    // threaded paints frames on a worker thread instead of in gameLoop(),
+    // softwareRaster fills the grid cells without QPainter (see BlockBatcher),
+    // target is the canvas' back buffer format and style picks grid blocks or
+    // pixel-space polygons (see GameRenderer)
+    MainWindow(quint64 seed, const QString &recordPath = QString(), const QString &profilePath = QString(),
+               bool threaded = false, bool softwareRaster = false,
+               RenderTarget::Kind target = RenderTarget::ImagePremultiplied,
+               GameRenderer::Style style = GameRenderer::GridStyle, QWidget *parent = nullptr);
     ~MainWindow();
 
 protected:
@@ -54,6 +56,7 @@ protected:
 private slots:
     void gameLoop(); // The main timer tick for game logic
     void on_clear_clicked(); // Clears screen and resets game
+    void presentRendered(); // Threaded mode: copies the worker's newest frame to the canvas
 
     // Stubs for your original drawing app
     void Mouse_Pressed();
@@ -64,80 +67,51 @@ private:
 
     // UI, Frame, & Grid
     int frame_width, frame_height;
-    int gap; // The size of one "pixel" in our game
 
     // Game State
-    QTimer *gameTimer;
-    bool isGameOver;
-    bool isInvincible; // For flashing after being hit
-    int invincibilityTimer;
-    int score;
-    int lives;
-
-    // World
-    int ground_y;
-    int min_x, max_x; // Left and right edges of the screen in grid units
-    int world_width;
-
-    // Dino
-    int dino_x, dino_y; // Dino's base position (front foot)
-    std::vector<QPoint> dinoShape; // The blocks that make up the dino
-    double dino_y_velocity;
-    bool isJumping;
-    bool haveShield;
-
-    // Physics
-    double gravity;
-    double jump_power;
-    int obstacle_speed;
-
-    // Obstacles
-    std::vector<Obstacle> obstacles;
-    int obstacle_spawn_timer;
-
-    // weapons
-    std::vector<Weapon> weapons;
-    int fireballCount; // number of fireballs the player currently has
-
-    // background
-    // parallax (grid units)
-    int mountain1Offset = 0;   // offset in grid units (can be negative)
-    int mountain2Offset = 0;
-    int mountain1Speed = 1;    // grid units per frame
-    int mountain2Speed = 2;
-    int mountain1PeakHeight = 18; // height in grid blocks
-    int mountain2PeakHeight = 12;
-
-    // static sun (grid coords & radius)
-    int sunGridX = 0;
-    int sunGridY = 0;
-    int sunRadiusGrid = 6;
+    QTimer *gameTimer; // Fires once per display refresh
+    qint64 lastFrameTime; // profiler.now() of the previous gameLoop(), ns
+    qint64 accumulator; // Real time not yet simulated, ns
+    GameWorld *world; // All simulation state, stepped once per timer tick
+    InputQueue inputQueue; // Gameplay keys not yet applied, stamped with profiler.now()
+    quint32 tickCount; // Ticks stepped this session (timestamps for the input log)
+    InputLog inputLog;
+    QString recordPath;
+
+    // Profiling
+    Profiler profiler;
+    QString profilePath;
+    bool showPerfHud; // F2
+    QString perfHudText;
+    qint64 lastPerfUpdate; // profiler.now() when the HUD text was last refreshed
+    bool latencyPending; // a key was applied but no frame showing it has been presented yet
+    qint64 latencyStart; // when that key was pressed
+    quint32 latencyTick; // tickCount of the first frame that shows it
+    GameRenderer renderer; // used when drawing on the GUI thread
+
+    // Pipelined mode: GUI thread simulates, renderThread paints (both null otherwise)
+    QThread *renderThread;
+    RenderWorker *renderWorker;
+    quint64 lastPresented; // serial of the worker frame now in the canvas
+
+    // World generation runs ahead on streamThread, so ticks only copy finished chunks
+    QThread *streamThread;
+    ChunkStreamer *chunkStreamer;
 
     // Original Drawing App State
-    QColor fill1, fill2, fill3, obstacleColor;
+    QColor fill2, fill3;
     std::vector<point_info> history;
     enum DrawingMode { Normal, SelectingPoints };
     DrawingMode currentDrawingMode;
 
     // --- Game Functions ---
-    QPoint to_grid(int curr_x, int curr_y); // Converts window pixels to grid units
-    QPoint from_grid(int grid_x, int grid_y); // Converts grid units to window pixels
-    void draw_grid_box(QPainter &painter, int x, int y, QColor c); // Draws one grid-sized block
-    void draw_grid(QPainter &painter); // Draws the background grid (currently unused)
-    void DrawBackground(QPainter&painter);
-    void restartGame(); // Resets all game variables and starts
-    void drawGame(); // Draws the entire game state to the screen
-    void updateDino(); // Handles dino's jump physics
-    void updateObstacles(); // Moves, spawns, and scores obstacles
-    void spawnObstacle(); // Creates a new obstacle
-    void checkAndHandleCollision(); // Checks for hits and updates lives
-    void gameOver(); // Stops the game and sets game over state
-    void updateStaircase();
-
-    // Weapon helpers
-    void updateWeapons();
-    void spawnWeapon();
-    void drawShield(QPainter &painter, int radiusGrid=5, QColor color=Qt::blue);
+    void restartGame(); // Resets the world and starts the timer
+    void startLoop(); // (Re)starts the timer without counting the time it was stopped
+    void drawGame(double alpha = 1.0); // Draws the game state, alpha of the way into the current tick
+    void gameOver(); // Stops the game timer and shows the game over screen
+    void recordKey(quint8 keys); // Adds a key that reached the game to the input log
+    void updatePerfHud(); // Refreshes the profiler lines a few times a second
+    void reportInputLatency(quint32 ticksShown); // Called when a frame drawn after ticksShown ticks is presented
 
 };
 #endif // MAINWINDOW_H
@@ -1,14 +1,14 @@
 #include "obstacle.h"
 
-Obstacle::Obstacle(int startX, int groundY, Type type)
+PixelObstacle::PixelObstacle(int startX, int groundY, Rng &rng, Type type)
     : type(type)
 {
     int width, height, y;
 
     if (type == Cactus) {
         // Random cactus height & size variety
-        width = 25 + QRandomGenerator::global()->bounded(20);
-        height = 40 + QRandomGenerator::global()->bounded(20);
+        width = 25 + rng.bounded(20);
+        height = 40 + rng.bounded(20);
         y = groundY - height;
         OBS_CLR=Qt::green;
     }
@@ -16,7 +16,7 @@ Obstacle::Obstacle(int startX, int groundY, Type type)
         width = 50;
         height = 30;
         // Random flight height
-        int flightLevel = QRandomGenerator::global()->bounded(3)+1;
+        int flightLevel = rng.bounded(3)+1;
         switch (flightLevel) {
         case 1: y = groundY - 80 - height / 2; break;// mid
         case 2: y = groundY - 140 - height / 2; break;// high
@@ -27,12 +27,17 @@ Obstacle::Obstacle(int startX, int groundY, Type type)
     rect = QRect(startX, y, width, height);
 }
 
-void Obstacle::update(int speed) {
+PixelObstacle::PixelObstacle(const QRect &rect, Type type)
+    : rect(rect), OBS_CLR(type == Cactus ? QColor(Qt::green) : QColor(Qt::gray)), type(type)
+{
+}
+
+void PixelObstacle::update(int speed) {
     // Move the obstacle left each frame
     rect.translate(-speed, 0);
 }
 
-void Obstacle::draw(QPainter &painter) {
+void PixelObstacle::draw(QPainter &painter) {
     painter.setBrush(OBS_CLR);
     painter.setPen(Qt::NoPen);
     painter.drawRect(rect);
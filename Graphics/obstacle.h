@@ -3,16 +3,18 @@
 
 #include <QRect>
 #include <QPainter>
-#include <QRandomGenerator>
+#include "rng.h"
 
-class Obstacle{
+// A pixel-space obstacle (the grid game's own is struct Obstacle in entitystore.h)
+class PixelObstacle{
     friend class Dino;
 public:
     constexpr static double BIRD_PROB=0.1;
     enum Type { Cactus, Bird }; // More can be added later
 
     // Constructor
-    Obstacle(int startX, int groundY, Type type = Cactus);
+    PixelObstacle(int startX, int groundY, Rng &rng, Type type = Cactus); // sizes drawn from the game's rng
+    explicit PixelObstacle(const QRect &rect, Type type = Cactus); // exact placement, e.g. mirroring a grid obstacle
 
     // Core game loop functions
     void update(int speed);       // move left
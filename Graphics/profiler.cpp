@@ -0,0 +1,124 @@
+#include "profiler.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>    // For std::nth_element, std::max_element
+
+Profiler::Profiler()
+    : allocNext(0), allocCount(0), framesWithAllocations(0), traceNext(0), traceWrapped(false)
+{
+    for (Window &w : windows) {
+        w.durations.assign(WindowSize, 0);
+    }
+    windows[Frame].starts.assign(WindowSize, 0);
+    allocations.assign(WindowSize, 0);
+    trace.reserve(TraceCapacity); // no allocation once recording has started
+    scratch.reserve(WindowSize);
+    clock.start();
+}
+
+const char *Profiler::phaseName(Phase phase) {
+    static const char *names[PhaseCount] = {
+        "frame", "step", "streamWorld", "updateDino", "updateWeapons",
+        "updateObstacles", "checkAndHandleCollision", "drawGame", "present",
+        "inputToFrame"
+    };
+    return names[phase];
+}
+
+void Profiler::record(Phase phase, qint64 start, qint64 end) {
+    Window &w = windows[phase];
+    w.durations[w.next] = end - start;
+    if (!w.starts.empty()) w.starts[w.next] = start;
+    w.next = (w.next + 1) % WindowSize;
+    w.count = std::min(w.count + 1, (int)WindowSize);
+
+    Event e = { start, end - start, phase };
+    if ((int)trace.size() < TraceCapacity) {
+        trace.push_back(e);
+    } else {
+        trace[traceNext] = e; // overwrite the oldest
+        traceNext = (traceNext + 1) % TraceCapacity;
+        traceWrapped = true;
+    }
+}
+
+Profiler::Stats Profiler::stats(Phase phase) const {
+    const Window &w = windows[phase];
+    Stats s;
+    s.samples = w.count;
+    if (w.count == 0) return s;
+
+    scratch.assign(w.durations.begin(), w.durations.begin() + w.count); // ring order does not matter here
+    auto at = [&](double q) {
+        auto nth = scratch.begin() + std::min(w.count - 1, int(q * w.count));
+        std::nth_element(scratch.begin(), nth, scratch.end());
+        return *nth / 1e6;
+    };
+    s.p50 = at(0.50);
+    s.p99 = at(0.99);
+    s.max = *std::max_element(scratch.begin(), scratch.end()) / 1e6;
+    return s;
+}
+
+double Profiler::fps() const {
+    const Window &w = windows[Frame];
+    if (w.count < 2) return 0.0;
+    int newest = (w.next + WindowSize - 1) % WindowSize;
+    int oldest = (w.next + WindowSize - w.count) % WindowSize;
+    qint64 span = w.starts[newest] - w.starts[oldest];
+    return span > 0 ? (w.count - 1) * 1e9 / span : 0.0;
+}
+
+void Profiler::recordAllocations(quint64 count) {
+    allocations[allocNext] = count;
+    allocNext = (allocNext + 1) % WindowSize;
+    allocCount = std::min(allocCount + 1, (int)WindowSize);
+    if (count > 0) framesWithAllocations++;
+}
+
+quint64 Profiler::maxAllocations() const {
+    if (allocCount == 0) return 0;
+    return *std::max_element(allocations.begin(), allocations.begin() + allocCount);
+}
+
+template <class F> void Profiler::forEachEvent(F f) const {
+    int n = (int)trace.size();
+    int first = traceWrapped ? traceNext : 0;
+    for (int i = 0; i < n; ++i) {
+        f(trace[(first + i) % n]);
+    }
+}
+
+bool Profiler::writeCsv(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+    QTextStream out(&file);
+    out.setRealNumberNotation(QTextStream::FixedNotation); // default would round timestamps to 6 digits
+    out.setRealNumberPrecision(3);
+    out << "phase,start_us,duration_us\n";
+    forEachEvent([&](const Event &e) {
+        out << phaseName(e.phase) << ',' << e.start / 1000.0 << ',' << e.duration / 1000.0 << '\n';
+    });
+    return true;
+}
+
+bool Profiler::writeChromeTrace(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+    QTextStream out(&file);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(3);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    forEachEvent([&](const Event &e) {
+        // one track (tid) per phase, so nested probes stay readable
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"" << phaseName(e.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << int(e.phase)
+            << ",\"ts\":" << e.start / 1000.0 << ",\"dur\":" << e.duration / 1000.0 << '}';
+        first = false;
+    });
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return true;
+}
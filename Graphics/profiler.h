@@ -0,0 +1,102 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <vector>
+
+// Frame-time profiler: scoped probes around each phase of a frame.
+// Every sample goes into a per-phase rolling window (for the p50/p99 HUD)
+// and into a ring of recent trace events that can be dumped on exit as CSV
+// or as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Probes take a Profiler pointer and do nothing when it is null, so the
+// headless tools pay nothing for them:
+//     { ProfileScope probe(profiler, Profiler::Dino); updateDino(); }
+//
+// It also keeps the number of heap allocations made by each frame's ticks,
+// as measured by AllocationCounter (only in binaries built with it).
+class Profiler
+{
+public:
+    enum Phase {
+        Frame,      // one whole gameLoop()
+        Step,       // one GameWorld::step()
+        Stream,     // GameWorld::streamWorld(): terrain and obstacles coming in
+        Dino,
+        Weapons,
+        Obstacles,
+        Collision,
+        Draw,       // GameRenderer::drawGame()
+        Present,    // GameCanvas::paintEvent() copying the back buffer out
+        Input,      // key press until the first frame showing its tick is handed to the canvas
+        PhaseCount
+    };
+
+    struct Stats {
+        int samples = 0;
+        double p50 = 0, p99 = 0, max = 0; // ms
+    };
+
+    static const int WindowSize = 256;      // samples per phase kept for percentiles
+    static const int TraceCapacity = 100000; // most recent trace events kept
+
+    Profiler();
+
+    qint64 now() const { return clock.nsecsElapsed(); }
+    void record(Phase phase, qint64 start, qint64 end);
+
+    Stats stats(Phase phase) const; // over the rolling window
+    double fps() const; // from the spacing of the last WindowSize frames
+
+    void recordAllocations(quint64 count); // allocations made during one frame's ticks
+    quint64 maxAllocations() const; // most recorded for one frame in the rolling window
+    quint64 allocatingFrames() const { return framesWithAllocations; } // since the start
+
+    static const char *phaseName(Phase phase);
+
+    bool writeCsv(const QString &path) const;         // phase,start_us,duration_us per event
+    bool writeChromeTrace(const QString &path) const; // "X" complete events, one track per phase
+
+private:
+    struct Window {
+        std::vector<qint64> durations; // ring, ns
+        std::vector<qint64> starts;    // ring, ns (only used for Frame, to derive fps)
+        int next = 0;
+        int count = 0;
+    };
+    struct Event {
+        qint64 start; // ns
+        qint64 duration; // ns
+        Phase phase;
+    };
+
+    template <class F> void forEachEvent(F f) const; // oldest first
+
+    QElapsedTimer clock;
+    Window windows[PhaseCount];
+    std::vector<quint64> allocations; // ring, per frame
+    int allocNext;
+    int allocCount;
+    quint64 framesWithAllocations;
+    std::vector<Event> trace; // ring
+    int traceNext;
+    bool traceWrapped;
+    mutable std::vector<qint64> scratch; // for percentiles
+};
+
+// Times the enclosing scope as one sample of phase
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler *profiler, Profiler::Phase phase)
+        : profiler(profiler), phase(phase), start(profiler ? profiler->now() : 0) {}
+    ~ProfileScope() { if (profiler) profiler->record(phase, start, profiler->now()); }
+
+private:
+    Profiler *profiler;
+    Profiler::Phase phase;
+    qint64 start;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,87 @@
+#include "rendertarget.h"
+
+#include <cstring>      // For memset
+
+RenderTarget::RenderTarget()
+    : currentKind(ImagePremultiplied), framebuffer(nullptr)
+{
+}
+
+RenderTarget::~RenderTarget()
+{
+    image = QImage(); // the wrapper must go before the memory it points at
+    delete[] framebuffer;
+}
+
+void RenderTarget::setKind(Kind kind)
+{
+    if (kind == currentKind) return;
+    currentKind = kind;
+
+    pixmap = QPixmap();
+    image = QImage();
+    delete[] framebuffer;
+    framebuffer = nullptr;
+    bufferSize = QSize();
+}
+
+QPaintDevice &RenderTarget::device(const QSize &size)
+{
+    if (size == bufferSize) {
+        if (currentKind == Pixmap) return pixmap;
+        return image;
+    }
+    bufferSize = size;
+
+    switch (currentKind) {
+    case Pixmap:
+        pixmap = QPixmap(size);
+        pixmap.fill(Qt::white);
+        return pixmap;
+    case ImagePremultiplied:
+        image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        break;
+    case ImageRGB32:
+        image = QImage(size, QImage::Format_RGB32);
+        break;
+    case Framebuffer: {
+        image = QImage();
+        delete[] framebuffer;
+        int bytesPerLine = size.width() * 4;
+        framebuffer = new uchar[size_t(bytesPerLine) * size.height()];
+        memset(framebuffer, 0xff, size_t(bytesPerLine) * size.height()); // white
+        image = QImage(framebuffer, size.width(), size.height(), bytesPerLine, QImage::Format_RGB32);
+        return image;
+    }
+    default:
+        break;
+    }
+    image.fill(Qt::white);
+    return image;
+}
+
+void RenderTarget::draw(QPainter &painter, const QRect &rect) const
+{
+    if (currentKind == Pixmap) {
+        if (!pixmap.isNull()) painter.drawPixmap(rect, pixmap, rect);
+    } else if (!image.isNull()) {
+        painter.drawImage(rect, image, rect);
+    }
+}
+
+const char *RenderTarget::kindName(Kind kind)
+{
+    static const char *names[KindCount] = { "pixmap", "argb32pm", "rgb32", "framebuffer" };
+    return names[kind];
+}
+
+bool RenderTarget::kindFromName(const QString &name, Kind &kind)
+{
+    for (int k = 0; k < KindCount; ++k) {
+        if (name == kindName(Kind(k))) {
+            kind = Kind(k);
+            return true;
+        }
+    }
+    return false;
+}
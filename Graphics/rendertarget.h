@@ -0,0 +1,49 @@
+#ifndef RENDERTARGET_H
+#define RENDERTARGET_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QPainter>
+#include <QString>
+
+// The back buffer drawGame() paints into, in one of several raster formats.
+// Which is fastest depends on the machine (how QPixmap is backed, whether
+// the screen is 32-bit RGB, ...), so it is picked at startup; see
+// "--target" and the "--compare-backends" mode in main.cpp.
+class RenderTarget
+{
+public:
+    enum Kind {
+        Pixmap,             // QPixmap, the platform's native raster format
+        ImagePremultiplied, // QImage ARGB32_Premultiplied (QPainter's fastest blend format)
+        ImageRGB32,         // QImage RGB32, no alpha channel
+        Framebuffer,        // our own malloc'd RGB32 memory, wrapped in a QImage without copying
+        KindCount
+    };
+
+    RenderTarget();
+    ~RenderTarget();
+
+    void setKind(Kind kind); // Drops the current buffer
+    Kind kind() const { return currentKind; }
+    bool isEmpty() const { return bufferSize.isEmpty(); } // nothing allocated yet
+    QSize size() const { return bufferSize; }
+
+    QPaintDevice &device(const QSize &size); // Reused every frame; (re)allocated and filled white when the size changes
+    void draw(QPainter &painter, const QRect &rect) const; // Copies rect of the buffer to the same place (in painter's coordinates)
+
+    static const char *kindName(Kind kind);
+    static bool kindFromName(const QString &name, Kind &kind); // false for an unknown name
+
+private:
+    RenderTarget(const RenderTarget &) = delete;
+    RenderTarget &operator=(const RenderTarget &) = delete;
+
+    Kind currentKind;
+    QSize bufferSize;
+    QPixmap pixmap;
+    QImage image; // also the wrapper around framebuffer
+    uchar *framebuffer;
+};
+
+#endif // RENDERTARGET_H
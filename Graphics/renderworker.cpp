@@ -0,0 +1,57 @@
+#include "renderworker.h"
+
+#include <QPainter>
+
+RenderWorker::RenderWorker(const GameWorld &prototype, const Profiler *clock)
+    : snapshots(FrameSnapshot{ prototype, 1.0, QString() }),
+      clock(clock),
+      rendered(0)
+{
+}
+
+void RenderWorker::renderLatest()
+{
+    if (!snapshots.update()) return; // already drew the newest one (signals can pile up)
+    const FrameSnapshot &snap = snapshots.front();
+
+    QSize size(snap.world.frame_width, snap.world.frame_height);
+    if (canvas.size() != size) {
+        canvas = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        canvas.fill(Qt::white);
+        renderer.invalidate();
+    }
+
+    // Draw into our own persistent canvas, exactly like the single-threaded path
+    qint64 start = clock->now();
+    QPainter painter(&canvas);
+    renderer.setPerfText(snap.perfText);
+    QRegion dirty = renderer.drawGame(painter, snap.world, snap.alpha);
+    painter.end();
+    qint64 end = clock->now();
+
+    for (QRegion &d : damage) d += dirty;
+
+    // Bring the output slot up to date: it is a few frames old, so copy
+    // everything that changed since it was last filled, not just this frame
+    int slot = frames.backIndex();
+    RenderedFrame &out = frames.back();
+    if (out.image.size() != size) {
+        out.image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        damage[slot] = QRect(QPoint(0, 0), size);
+    }
+    QPainter copy(&out.image);
+    copy.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect &r : damage[slot]) {
+        copy.drawImage(r, canvas, r);
+    }
+    copy.end();
+    damage[slot] = QRegion();
+
+    out.dirty = dirty;
+    out.serial = ++rendered;
+    out.drawStart = start;
+    out.drawEnd = end;
+    out.ticks = snap.ticks;
+    frames.publish();
+    emit frameReady();
+}
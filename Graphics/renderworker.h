@@ -0,0 +1,64 @@
+#ifndef RENDERWORKER_H
+#define RENDERWORKER_H
+
+#include <QObject>
+#include <QImage>
+#include <QRegion>
+#include <QString>
+#include "gameworld.h"
+#include "gamerenderer.h"
+#include "profiler.h"
+#include "triplebuffer.h"
+
+// Everything the renderer needs for one frame, copied out of the live world
+// by the GUI thread. Never changed once published.
+struct FrameSnapshot {
+    GameWorld world;
+    double alpha; // how far between the last two ticks to draw
+    QString perfText; // profiler HUD lines, empty when hidden
+    quint32 ticks = 0; // ticks stepped when it was taken (MainWindow's tickCount)
+};
+
+// One finished frame, owned by whichever side holds its slot
+struct RenderedFrame {
+    QImage image;
+    QRegion dirty; // what changed since the frame with serial - 1
+    quint64 serial = 0; // counts rendered frames (skipped snapshots do not count)
+    qint64 drawStart = 0, drawEnd = 0; // Profiler::now() around drawGame()
+    quint32 ticks = 0; // of the snapshot it was drawn from
+};
+
+// Pipelined rendering: lives on its own QThread and turns the newest
+// FrameSnapshot into a RenderedFrame. The GUI thread keeps simulating and
+// handling keys while a frame is being painted, and only copies finished
+// frames to the screen.
+//
+//     GUI: snapshots.back() = ...; snapshots.publish(); -> renderLatest() (queued)
+//     worker: draws, frames.publish(); -> frameReady() (queued)
+//     GUI: if (frames.update()) present frames.front()
+class RenderWorker : public QObject
+{
+    Q_OBJECT
+public:
+    RenderWorker(const GameWorld &prototype, const Profiler *clock);
+    void setBackend(BlockBatcher::Backend backend) { renderer.setBackend(backend); } // call before moveToThread()
+    void setStyle(GameRenderer::Style style) { renderer.setStyle(style); } // likewise
+
+    TripleBuffer<FrameSnapshot> snapshots; // GUI thread produces, worker consumes
+    TripleBuffer<RenderedFrame> frames;    // worker produces, GUI thread consumes
+
+public slots:
+    void renderLatest(); // Draws the newest snapshot, if there is one we have not drawn
+
+signals:
+    void frameReady();
+
+private:
+    GameRenderer renderer;
+    QImage canvas; // persistent target, so drawGame() can repaint only what changed
+    QRegion damage[3]; // per output slot: what changed in canvas since that slot was last filled
+    const Profiler *clock; // only now() is used; samples are recorded on the GUI thread
+    quint64 rendered; // frames published so far
+};
+
+#endif // RENDERWORKER_H
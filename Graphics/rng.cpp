@@ -0,0 +1,11 @@
+#include "rng.h"
+
+void Rng::setSeed(quint64 seed)
+{
+    // Standard PCG32 seeding: fixed stream, state advanced past the seed
+    state = 0;
+    increment = (0xda3e39cb94b95bdbULL << 1u) | 1u;
+    next();
+    state += seed;
+    next();
+}
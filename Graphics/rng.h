@@ -0,0 +1,34 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <QtGlobal>
+
+// Small seedable PRNG (PCG32, XSH-RR variant). The world generator carries one
+// from chunk to chunk (ChunkState), so a run is fully determined by its seed
+// plus the keys pressed; see InputLog. Copyable, so a chunk carries the
+// random stream on to the next one.
+class Rng
+{
+public:
+    explicit Rng(quint64 seed = 0) { setSeed(seed); }
+
+    void setSeed(quint64 seed);
+
+    quint32 next()
+    {
+        quint64 old = state;
+        state = old * 6364136223846793005ULL + increment;
+        quint32 xorshifted = quint32(((old >> 18u) ^ old) >> 27u);
+        quint32 rot = quint32(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform in [0, bound); bound must be > 0. Multiply-shift, no division.
+    int bounded(int bound) { return int((quint64(next()) * quint32(bound)) >> 32); }
+
+private:
+    quint64 state;
+    quint64 increment; // must be odd
+};
+
+#endif // RNG_H
@@ -0,0 +1,81 @@
+#include "gameworld.h"
+#include "inputlog.h"
+#include "allocationcounter.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <cstdlib>      // For atoll()
+#include <cstring>      // For strcmp()
+
+// Replays a log written by "DinoGame --record FILE" and prints the end state,
+// which is identical on every run of the same log
+static int replay(const char *path)
+{
+    InputLog log;
+    if (!log.load(QString::fromLocal8Bit(path))) {
+        qWarning() << "Not a valid input log:" << path;
+        return 1;
+    }
+
+    GameWorld world(log.frame_width, log.frame_height, log.gap, log.seed);
+    QElapsedTimer timer;
+    timer.start();
+    log.replay(world);
+    qint64 ms = timer.elapsed();
+
+    qInfo() << "ticks:" << log.endTick << "keys:" << log.events.size()
+            << "score:" << world.score << "lives:" << world.lives
+            << "game over:" << world.isGameOver << "dino_y:" << world.dino_y
+            << "obstacles:" << world.obstacles.size() << "time (ms):" << ms;
+    return 0;
+}
+
+// Usage: soak [frames] [seed]
+//        soak --replay FILE
+// Plays the game with a trivial "jump when something is close" bot,
+// restarting after every game over, and reports the simulation rate.
+int main(int argc, char *argv[])
+{
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+        return replay(argv[2]);
+
+    long long frames = (argc > 1) ? atoll(argv[1]) : 100000;
+    quint64 seed = (argc > 2) ? quint64(atoll(argv[2])) : 1;
+
+    GameWorld world(GameWorld::DEFAULT_WIDTH, GameWorld::DEFAULT_HEIGHT, GameWorld::DEFAULT_GAP, seed);
+
+    int games = 1;
+    long long totalScore = 0;
+    QElapsedTimer timer;
+    timer.start();
+    quint64 allocations = AllocationCounter::count(); // the world's pools are already allocated
+
+    for (long long f = 0; f < frames; ++f) {
+        if (world.isGameOver) {
+            totalScore += world.score;
+            world.restartGame();
+            games++;
+        }
+
+        GameInputs inputs;
+        for (const Obstacle &ob : world.obstacles) {
+            int dist = ob.x - world.dino_x;
+            if (!ob.destroyed && dist > 0 && dist < 12) {
+                inputs.jump = !world.isJumping;
+                break;
+            }
+        }
+        world.step(inputs);
+    }
+    totalScore += world.score;
+    allocations = AllocationCounter::count() - allocations;
+
+    qint64 ms = timer.elapsed();
+    double fps = ms > 0 ? frames * 1000.0 / ms : 0.0;
+    qInfo() << "frames:" << frames << "games:" << games
+            << "avg score:" << double(totalScore) / games
+            << "time (ms):" << ms << "frames/s:" << fps
+            << (AllocationCounter::countsMalloc() ? "heap allocations:" : "operator new calls:") << allocations;
+    return 0;
+}
@@ -0,0 +1,14 @@
+# Headless soak runner: steps GameWorld with a simple bot, no QApplication or paint path.
+QT = core
+
+CONFIG += c++17 console count_allocations # reports the loop's heap allocations
+CONFIG -= app_bundle
+
+# The qDebug() lines on game events (speed-ups, game over) allocate inside
+# QDebug; compile them out so the count is the simulation's own
+DEFINES += QT_NO_DEBUG_OUTPUT
+
+include(../core.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,84 @@
+#include "spritemask.h"
+
+#include <QtAlgorithms> // For qPopulationCount()
+#include <algorithm>    // For std::min/max
+
+// All-ones mask for the lowest n bits (n in 0..64)
+static quint64 lowBits(int n)
+{
+    return n >= 64 ? ~quint64(0) : ((quint64(1) << n) - 1);
+}
+
+SpriteMask::SpriteMask() : x0(0), y0(0), w(0), h(0)
+{
+}
+
+SpriteMask::SpriteMask(int left, int top, int width, int height)
+    : x0(left), y0(top), w(width), h(height), rows(height, 0)
+{
+    Q_ASSERT(width >= 0 && width <= MaxWidth);
+}
+
+SpriteMask SpriteMask::fromCells(const std::vector<QPoint> &cells)
+{
+    if (cells.empty()) return SpriteMask();
+
+    int left = cells[0].x(), right = left, top = cells[0].y(), bottom = top;
+    for (const QPoint &c : cells) {
+        left = std::min(left, c.x()); right = std::max(right, c.x());
+        top = std::min(top, c.y()); bottom = std::max(bottom, c.y());
+    }
+    SpriteMask mask(left, top, right - left + 1, bottom - top + 1);
+    for (const QPoint &c : cells) {
+        mask.setCell(c.x(), c.y());
+    }
+    return mask;
+}
+
+void SpriteMask::setCell(int x, int y)
+{
+    Q_ASSERT(x >= x0 && x < x0 + w && y >= y0 && y < y0 + h);
+    rows[y - y0] |= quint64(1) << (x - x0);
+}
+
+bool SpriteMask::testCell(int x, int y) const
+{
+    if (x < x0 || x >= x0 + w || y < y0 || y >= y0 + h) return false;
+    return (rows[y - y0] >> (x - x0)) & 1;
+}
+
+int SpriteMask::overlapRect(QPoint pos, int x, int y, int rw, int rh) const
+{
+    // Work in this mask's local coords
+    int rx = x - pos.x(), ry = y - pos.y();
+    int firstRow = std::max(y0, ry), lastRow = std::min(y0 + h, ry + rh); // [first, last)
+    int firstCol = std::max(x0, rx), lastCol = std::min(x0 + w, rx + rw);
+    if (firstRow >= lastRow || firstCol >= lastCol) return 0;
+
+    quint64 span = lowBits(lastCol - firstCol) << (firstCol - x0);
+    int count = 0;
+    for (int r = firstRow; r < lastRow; ++r) {
+        count += qPopulationCount(rows[r - y0] & span);
+    }
+    return count;
+}
+
+int SpriteMask::overlapMask(QPoint pos, const SpriteMask &other, QPoint otherPos) const
+{
+    // Other mask's box relative to this mask's local coords
+    int ox = otherPos.x() + other.x0 - pos.x();
+    int oy = otherPos.y() + other.y0 - pos.y();
+    int firstRow = std::max(y0, oy), lastRow = std::min(y0 + h, oy + other.h);
+    if (firstRow >= lastRow) return 0;
+
+    int shift = ox - x0; // other's bit 0 sits at this mask's bit 'shift'
+    if (shift >= 64 || shift <= -64) return 0;
+
+    int count = 0;
+    for (int r = firstRow; r < lastRow; ++r) {
+        quint64 theirs = other.rows[r - oy];
+        theirs = shift >= 0 ? (theirs << shift) : (theirs >> -shift);
+        count += qPopulationCount(rows[r - y0] & theirs);
+    }
+    return count;
+}
@@ -0,0 +1,46 @@
+#ifndef SPRITEMASK_H
+#define SPRITEMASK_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <vector>
+
+// A sprite's shape as one 64-bit row bitmask per row (bit i = column left()+i),
+// in the sprite's own local coordinates. Collision between two placed masks is
+// a shift-and-AND per overlapping row instead of a cell-by-cell loop.
+//
+// Units are whatever the caller uses: grid cells in the grid game, or cells of
+// a fixed pixel size for the polygon Dino/Obstacle classes.
+class SpriteMask
+{
+public:
+    static const int MaxWidth = 64;
+
+    SpriteMask();
+    SpriteMask(int left, int top, int width, int height); // empty mask over that local box
+
+    static SpriteMask fromCells(const std::vector<QPoint> &cells); // bounding box of the cells, cells set
+
+    void setCell(int x, int y);        // local coords, must be inside the box
+    bool testCell(int x, int y) const; // local coords, false outside the box
+
+    // Number of set cells that land inside the w x h rect at (x, y)
+    // when this mask's local origin is placed at pos.
+    int overlapRect(QPoint pos, int x, int y, int w, int h) const;
+    // Number of cells set in both masks when placed at pos / otherPos
+    int overlapMask(QPoint pos, const SpriteMask &other, QPoint otherPos) const;
+    bool overlaps(QPoint pos, const SpriteMask &other, QPoint otherPos) const { return overlapMask(pos, other, otherPos) > 0; }
+
+    int left() const { return x0; }
+    int top() const { return y0; }
+    int width() const { return w; }
+    int height() const { return h; }
+    bool isEmpty() const { return h == 0; }
+
+private:
+    int x0, y0; // local coords of bit 0 of rows[0]
+    int w, h;
+    std::vector<quint64> rows;
+};
+
+#endif // SPRITEMASK_H
@@ -0,0 +1,145 @@
+#include "spritesheet.h"
+
+#include <QFile>
+
+// C++ Standard Library includes
+#include <algorithm>    // For std::any_of
+#include <cstring>      // For memcmp
+
+static const char SHEET_MAGIC[4] = { 'D', 'S', 'P', 'R' };
+static const quint8 SHEET_VERSION = 1;
+
+// --- Little-endian reads, bounds-checked against the end of the data ---
+namespace {
+struct Reader {
+    const uchar *p, *end;
+    bool ok = true;
+
+    bool has(qint64 n) { ok = ok && end - p >= n; return ok; }
+    quint64 bytes(int n)
+    {
+        if (!has(n)) return 0;
+        quint64 v = 0;
+        for (int i = 0; i < n; ++i) v |= quint64(p[i]) << (8 * i);
+        p += n;
+        return v;
+    }
+    quint8 u8() { return quint8(bytes(1)); }
+    qint8 s8() { return qint8(bytes(1)); }
+};
+}
+
+bool SpriteSheet::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(file.errorString());
+    }
+    uchar *data = file.map(0, file.size()); // resources compiled in uncompressed map straight into the binary
+    if (!data) {
+        return fail(file.errorString());
+    }
+    bool ok = load(data, file.size());
+    file.unmap(data);
+    return ok;
+}
+
+bool SpriteSheet::fail(const QString &why)
+{
+    // A sheet is loaded whole or not at all
+    frames.clear();
+    colors.clear();
+    for (std::vector<int> &list : animationFrames) list.clear();
+    for (int &t : animationTicks) t = 0;
+    error = why;
+    return false;
+}
+
+bool SpriteSheet::load(const uchar *data, qint64 size)
+{
+    fail(QString()); // start empty
+
+    Reader in{ data, data + size };
+    if (!in.has(8) || memcmp(data, SHEET_MAGIC, 4) != 0) {
+        return fail("not a sprite sheet");
+    }
+    in.p += 4;
+    if (in.u8() != SHEET_VERSION) {
+        return fail("unsupported sprite sheet version");
+    }
+    int paletteSize = in.u8();
+    int frameCount = in.u8();
+    in.u8(); // reserved
+    if (frameCount == 0) {
+        return fail("sprite sheet has no frames");
+    }
+
+    for (int i = 0; i < paletteSize; ++i) colors.push_back(quint32(in.bytes(4)));
+
+    for (int f = 0; f < frameCount && in.ok; ++f) {
+        Frame frame;
+        int animation = in.u8();
+        frame.ticks = in.u8();
+        int width = in.u8(), height = in.u8();
+        int left = in.s8(), top = in.s8();
+        int cellCount = int(in.bytes(2));
+        if (animation >= AnimationCount || frame.ticks == 0 || width < 1 || width > SpriteMask::MaxWidth) {
+            return fail(QString("bad header in frame %1").arg(f));
+        }
+        frame.animation = Animation(animation);
+
+        frame.mask = SpriteMask(left, top, width, height);
+        bool outside = false; // bits past the width would silently vanish
+        for (int y = 0; y < height; ++y) {
+            quint64 row = in.bytes(8);
+            if (width < SpriteMask::MaxWidth && (row >> width) != 0) outside = true;
+            for (int x = 0; x < width; ++x) {
+                if (row & (quint64(1) << x)) {
+                    frame.cells.push_back(QPoint(left + x, top + y));
+                    frame.mask.setCell(left + x, top + y);
+                }
+            }
+        }
+        for (int c = 0; c < cellCount; ++c) frame.colors.push_back(in.u8());
+
+        if (in.ok && (outside || int(frame.cells.size()) != cellCount ||
+                      std::any_of(frame.colors.begin(), frame.colors.end(), [&](quint8 c) { return c >= paletteSize; }))) {
+            return fail(QString("bad cells in frame %1").arg(f));
+        }
+        animationFrames[frame.animation].push_back(int(frames.size()));
+        animationTicks[frame.animation] += frame.ticks;
+        frames.push_back(frame);
+    }
+    if (!in.ok || frames.empty()) {
+        return fail("truncated sprite sheet");
+    }
+    error.clear();
+    return true;
+}
+
+int SpriteSheet::frameAt(Animation animation, int tick) const
+{
+    if (animationFrames[animation].empty()) {
+        return animation == Standing ? 0 : frameAt(Standing, tick);
+    }
+    int t = tick % animationTicks[animation];
+    for (int i : animationFrames[animation]) {
+        t -= frames[i].ticks;
+        if (t < 0) return i;
+    }
+    return animationFrames[animation].back();
+}
+
+static SpriteSheet loadDino()
+{
+    // Compiled in (see core.pri), so this only fails if the file itself is broken
+    SpriteSheet sheet;
+    if (!sheet.load(":/sprites/dino.sprites")) qFatal("dino.sprites: %s", qPrintable(sheet.errorString()));
+    return sheet;
+}
+
+const SpriteSheet &SpriteSheet::dino()
+{
+    static const SpriteSheet sheet = loadDino(); // thread-safe, once
+    return sheet;
+}
@@ -0,0 +1,63 @@
+#ifndef SPRITESHEET_H
+#define SPRITESHEET_H
+
+#include <QPoint>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include "spritemask.h"
+
+// Grid sprites with animation frames, loaded from a small binary file that
+// is memory-mapped and decoded once. Each frame is ready to use as soon as
+// it is loaded: its cells (for drawing), their colours, and the SpriteMask
+// used for collisions, so nothing is built per tick or per frame.
+//
+// File layout (little endian): "DSPR", version byte, palette size, frame
+// count, one reserved byte; the palette as 32-bit ARGB; then per frame:
+// animation, ticks shown, width (1..64) and height in cells, left and top
+// of the box relative to the anchor (signed bytes; the anchor is the cell
+// the sprite stands on, e.g. the dino's front foot), cell count (16 bits),
+// one 64-bit row bitmask per row (bit i = column left + i), and one palette
+// index per set bit in row order.
+//
+// Sheets are not edited by hand: each has a text source with the frames
+// drawn as rows of characters (e.g. dino.sprites.txt), which
+// tools/spritepack turns into this layout.
+class SpriteSheet
+{
+public:
+    enum Animation { Standing, Running, Ducking, AnimationCount };
+
+    struct Frame {
+        Animation animation = Standing;
+        int ticks = 1;              // how long the frame is shown
+        std::vector<QPoint> cells;  // relative to the anchor, row by row
+        std::vector<quint8> colors; // palette index per cell
+        SpriteMask mask;            // cells as row bitmasks
+    };
+
+    bool load(const QString &path); // memory-maps the file; false (see errorString()) if it is not a valid sheet
+    bool load(const uchar *data, qint64 size); // on failure the sheet is left empty
+    QString errorString() const { return error; }
+
+    int frameCount() const { return int(frames.size()); }
+    const Frame &frame(int i) const { return frames[i]; }
+    const std::vector<quint32> &palette() const { return colors; } // ARGB
+
+    // Frame shown tick ticks into a looping animation. Animations the sheet
+    // has no frames for fall back to Standing, and that to frame 0.
+    int frameAt(Animation animation, int tick) const;
+
+    static const SpriteSheet &dino(); // the built-in ":/sprites/dino.sprites", decoded on first use
+
+private:
+    bool fail(const QString &why); // clears everything loaded so far and returns false
+
+    std::vector<Frame> frames;
+    std::vector<quint32> colors;
+    std::vector<int> animationFrames[AnimationCount]; // frame indices, in file order
+    int animationTicks[AnimationCount] = {}; // one loop of each
+    QString error;
+};
+
+#endif // SPRITESHEET_H
@@ -0,0 +1,47 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+
+// Lock-free single-producer / single-consumer FIFO with a fixed number of
+// slots. tryPush() fails when the queue is full and tryPop() when it is
+// empty; neither ever blocks or allocates. One thread may push and one
+// (other) thread may pop at the same time.
+template <class T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(int capacity) : items(capacity + 1), head(0), tail(0) {}
+
+    // --- Producer side ---
+    bool tryPush(const T &item)
+    {
+        int t = tail.load(std::memory_order_relaxed);
+        int next = (t + 1) % int(items.size());
+        if (next == head.load(std::memory_order_acquire)) return false; // full
+        items[t] = item;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumer side ---
+    bool tryPop(T &item)
+    {
+        int h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false; // empty
+        item = items[h];
+        head.store((h + 1) % int(items.size()), std::memory_order_release);
+        return true;
+    }
+
+private:
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    std::vector<T> items; // one slot stays empty so full and empty differ
+    std::atomic<int> head; // next slot to pop, written by the consumer
+    std::atomic<int> tail; // next slot to fill, written by the producer
+};
+
+#endif // SPSCQUEUE_H
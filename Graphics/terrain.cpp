@@ -0,0 +1,23 @@
+#include "terrain.h"
+
+#include <algorithm>    // For std::max
+
+Terrain::Terrain()
+    : firstColumn(0)
+{
+}
+
+void Terrain::reset(int first, int last)
+{
+    firstColumn = first;
+    if (heights.capacity() != last - first + 1) heights.setCapacity(last - first + 1);
+    heights.clear();
+    while (heights.size() < heights.capacity()) heights.push_back(0);
+}
+
+int Terrain::highest() const
+{
+    int h = 0;
+    for (int i = 0; i < heights.size(); ++i) h = std::max(h, int(heights[i]));
+    return h;
+}
@@ -0,0 +1,41 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <QtGlobal>
+#include "entitystore.h"
+
+// Rolling ground on screen: a height in grid cells for every column between
+// first and last screen column (as given to reset()), one byte each, in a
+// ring that drops the left edge as new columns come in on the right, so a
+// long run holds no more state than a short one. The heights themselves
+// come from WorldGenerator, one chunk at a time.
+//
+// Neighbouring columns never differ by more than one cell, so the whole
+// height-field can be walked on. height() is a single array lookup.
+class Terrain
+{
+public:
+    Terrain();
+
+    // Flat ground on columns first..last (screen grid x); others read as 0
+    void reset(int first, int last);
+    void scrollIn(int h) // Everything moves left by one column; h is the new one on the right
+    {
+        heights.pop_front();
+        heights.push_back(quint8(h));
+    }
+
+    int height(int column) const
+    {
+        int i = column - firstColumn;
+        return (i >= 0 && i < heights.size()) ? heights[i] : 0;
+    }
+    int lastColumn() const { return firstColumn + heights.size() - 1; } // where new columns come in
+    int highest() const; // tallest stored column
+
+private:
+    RingBuffer<quint8> heights; // screen columns firstColumn.. in order
+    int firstColumn;
+};
+
+#endif // TERRAIN_H
@@ -0,0 +1,101 @@
+#include "blockbatcher.h"
+#include "rng.h"
+
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+
+// The Software backend writes pixels itself instead of calling drawRects(),
+// and is only allowed to do so because the result is identical. Each case
+// draws the same random layers through both backends and compares images.
+class BlockBatcherTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesPainter_data();
+    void matchesPainter();
+
+private:
+    static QImage render(BlockBatcher::Backend backend, QImage::Format format, int gap, const QRegion &clip, quint64 seed);
+};
+
+// format x gap x clip
+void BlockBatcherTest::matchesPainter_data()
+{
+    QTest::addColumn<int>("format");
+    QTest::addColumn<int>("gap");
+    QTest::addColumn<bool>("clipped");
+
+    const QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied };
+    const char *names[] = { "RGB32", "ARGB32", "ARGB32_Premultiplied" };
+    const int gaps[] = { 1, 4, 10 };
+    for (int f = 0; f < 3; ++f)
+        for (int gap : gaps)
+            for (bool clipped : { false, true })
+                QTest::addRow("%s-gap%d-%s", names[f], gap, clipped ? "clip" : "noclip")
+                    << int(formats[f]) << gap << clipped;
+}
+
+void BlockBatcherTest::matchesPainter()
+{
+    QFETCH(int, format);
+    QFETCH(int, gap);
+    QFETCH(bool, clipped);
+
+    // Like the dirty rects GameRenderer clips to: a few separate areas,
+    // one of them hanging off the image
+    QRegion clip;
+    if (clipped) {
+        clip += QRect(10, 5, 120, 40);
+        clip += QRect(150, 60, 200, 90);
+        clip += QRect(-20, 170, 60, 60);
+    }
+
+    for (quint64 seed = 1; seed <= 20; ++seed) {
+        QImage painted = render(BlockBatcher::PainterBackend, QImage::Format(format), gap, clip, seed);
+        QImage software = render(BlockBatcher::SoftwareBackend, QImage::Format(format), gap, clip, seed);
+        QCOMPARE(software.format(), painted.format());
+        QCOMPARE(software, painted);
+    }
+}
+
+// Three layers of random cells in a few opaque colours: single cells,
+// horizontal and vertical runs (which the batcher merges), some partly or
+// wholly off the image, enough of them for the banded parallel fill
+QImage BlockBatcherTest::render(BlockBatcher::Backend backend, QImage::Format format, int gap,
+                                const QRegion &clip, quint64 seed)
+{
+    const QColor colors[] = { QColor(20, 4, 41), QColor(18, 141, 21), QColor(255, 215, 0),
+                              QColor(210, 80, 60), QColor(255, 255, 255) };
+    Rng rng(seed);
+
+    QImage image(300, 200, format);
+    image.fill(QColor(90, 120, 200));
+
+    BlockBatcher batcher;
+    batcher.setBackend(backend);
+    QPainter painter(&image);
+    if (!clip.isEmpty()) painter.setClipRegion(clip);
+
+    int columns = image.width() / gap + 2, rows = image.height() / gap + 2;
+    for (int layer = 0; layer < 3; ++layer) {
+        batcher.setGrid(rng.bounded(2 * gap + 1) - gap, rng.bounded(2 * gap + 1) - gap, gap);
+        for (int i = 0; i < 150; ++i) {
+            const QColor &c = colors[rng.bounded(5)];
+            int x = rng.bounded(columns + 4) - 2, y = rng.bounded(rows + 4) - 2;
+            int length = 1 + rng.bounded(6);
+            bool vertical = rng.bounded(2) == 0;
+            for (int k = 0; k < length; ++k) {
+                batcher.add(vertical ? x : x + k, vertical ? y + k : y, c);
+            }
+        }
+        batcher.flush(painter);
+    }
+    painter.end();
+    return image;
+}
+
+QTEST_APPLESS_MAIN(BlockBatcherTest)
+
+#include "blockbatchertest.moc"
@@ -0,0 +1,16 @@
+# BlockBatcher's software backend must match QPainter::drawRects() pixel for pixel
+QT = core gui testlib concurrent
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    ../../blockbatcher.cpp \
+    blockbatchertest.cpp
+
+HEADERS += \
+    ../../blockbatcher.h
@@ -0,0 +1,144 @@
+#include "gameworld.h"
+
+#include <QtTest>
+
+// After a hit the dino can't be hit again for INVINCIBLE_TICKS and
+// flickers in FLASH_TICKS phases. Both run on GameWorld's TickTimers, so
+// stepping the world tick by tick must end them on exact ticks.
+class InvincibilityTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void startsVulnerable();
+    void endsAfterInvincibleTicks();
+    void flashToggles();
+    void pauseStopsTheTimers();
+    void restartClears();
+    void obstacleHitStartsIt();
+
+private:
+    GameWorld *world = nullptr;
+    void step(int ticks = 1); // with no obstacles in the way, so nothing else hits the dino
+};
+
+void InvincibilityTest::init()
+{
+    delete world;
+    world = new GameWorld(GameWorld::DEFAULT_WIDTH, GameWorld::DEFAULT_HEIGHT, GameWorld::DEFAULT_GAP);
+    world->restartGame();
+}
+
+void InvincibilityTest::cleanup()
+{
+    delete world;
+    world = nullptr;
+}
+
+void InvincibilityTest::step(int ticks)
+{
+    for (int i = 0; i < ticks; ++i) {
+        world->obstacles.clear();
+        world->step(GameInputs());
+    }
+}
+
+void InvincibilityTest::startsVulnerable()
+{
+    QVERIFY(!world->isInvincible());
+    QVERIFY(!world->dinoFlash);
+    step(10);
+    QVERIFY(!world->isInvincible());
+    QVERIFY(!world->dinoFlash);
+}
+
+void InvincibilityTest::endsAfterInvincibleTicks()
+{
+    world->startInvincibility();
+    for (int tick = 1; tick < GameWorld::INVINCIBLE_TICKS; ++tick) {
+        step();
+        QVERIFY2(world->isInvincible(), qPrintable(QString("ended early, after %1 ticks").arg(tick)));
+    }
+    step();
+    QVERIFY(!world->isInvincible());
+    QVERIFY(!world->dinoFlash); // shown normally again
+    step(GameWorld::FLASH_TICKS * 3);
+    QVERIFY(!world->dinoFlash);
+}
+
+// Flash (hidden) for the first FLASH_TICKS, then shown for FLASH_TICKS, and so on
+void InvincibilityTest::flashToggles()
+{
+    world->startInvincibility();
+    QVERIFY(world->dinoFlash);
+    for (int tick = 1; tick < GameWorld::INVINCIBLE_TICKS; ++tick) {
+        step();
+        bool hidden = (tick / GameWorld::FLASH_TICKS) % 2 == 0;
+        QVERIFY2(world->dinoFlash == hidden, qPrintable(QString("wrong phase after %1 ticks").arg(tick)));
+    }
+
+    // The first toggle, spelled out
+    init();
+    world->startInvincibility();
+    step(GameWorld::FLASH_TICKS - 1);
+    QVERIFY(world->dinoFlash);
+    step();
+    QVERIFY(!world->dinoFlash);
+}
+
+void InvincibilityTest::pauseStopsTheTimers()
+{
+    world->startInvincibility();
+    step(3);
+    int remaining = world->invincibleTimer.remainingTicks();
+    world->togglePause();
+    step(GameWorld::INVINCIBLE_TICKS * 2);
+    QVERIFY(world->isInvincible());
+    QCOMPARE(world->invincibleTimer.remainingTicks(), remaining);
+    world->togglePause();
+    step(remaining - 1);
+    QVERIFY(world->isInvincible());
+    step();
+    QVERIFY(!world->isInvincible());
+}
+
+void InvincibilityTest::restartClears()
+{
+    world->startInvincibility();
+    step(2);
+    world->restartGame();
+    QVERIFY(!world->isInvincible());
+    QVERIFY(!world->dinoFlash);
+    step();
+    QVERIFY(!world->dinoFlash);
+}
+
+// The real path: a tall obstacle that reaches the dino this tick
+void InvincibilityTest::obstacleHitStartsIt()
+{
+    auto hitNextTick = [this]() {
+        world->obstacles.clear();
+        world->obstacles.push_back(Obstacle(world->dino_x + world->obstacle_speed, 10, false, false));
+        world->step(GameInputs());
+    };
+
+    hitNextTick();
+    QCOMPARE(world->lives, 2);
+    QVERIFY(world->isInvincible());
+    QVERIFY(world->dinoFlash);
+
+    // Hits while invincible don't count
+    for (int tick = 1; tick < GameWorld::INVINCIBLE_TICKS; ++tick) hitNextTick();
+    QCOMPARE(world->lives, 2);
+
+    // The tick invincibility runs out, the dino can be hit again
+    hitNextTick();
+    QCOMPARE(world->lives, 1);
+    QVERIFY(world->isInvincible());
+}
+
+QTEST_APPLESS_MAIN(InvincibilityTest)
+
+#include "invincibilitytest.moc"
@@ -0,0 +1,10 @@
+# GameWorld's invincibility and flicker timers, tick by tick
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+    invincibilitytest.cpp
@@ -0,0 +1,220 @@
+#include "spritemask.h"
+#include "rng.h"
+
+#include <QtTest>
+
+// SpriteMask's row-bitmask queries, checked against plain cell-by-cell
+// counting (testCell() over the whole box), including the 64-bit edge.
+class SpriteMaskTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fromCellsBounds();
+    void fromCellsEmpty();
+    void testCellOutsideMask();
+    void overlapRect_data();
+    void overlapRect();
+    void overlapMask_data();
+    void overlapMask();
+    void lastColumn();
+    void matchesCellByCell();
+
+private:
+    static SpriteMask randomMask(Rng &rng);
+    static int countInRect(const SpriteMask &mask, QPoint pos, const QRect &rect);
+    static int countBoth(const SpriteMask &a, QPoint aPos, const SpriteMask &b, QPoint bPos);
+};
+
+// --- Reference answers, one cell at a time ---
+
+int SpriteMaskTest::countInRect(const SpriteMask &mask, QPoint pos, const QRect &rect)
+{
+    int count = 0;
+    for (int y = mask.top(); y < mask.top() + mask.height(); ++y)
+        for (int x = mask.left(); x < mask.left() + mask.width(); ++x)
+            if (mask.testCell(x, y) && rect.contains(pos + QPoint(x, y))) count++;
+    return count;
+}
+
+int SpriteMaskTest::countBoth(const SpriteMask &a, QPoint aPos, const SpriteMask &b, QPoint bPos)
+{
+    int count = 0;
+    for (int y = a.top(); y < a.top() + a.height(); ++y)
+        for (int x = a.left(); x < a.left() + a.width(); ++x) {
+            QPoint inB = aPos + QPoint(x, y) - bPos;
+            if (a.testCell(x, y) && b.testCell(inB.x(), inB.y())) count++;
+        }
+    return count;
+}
+
+SpriteMask SpriteMaskTest::randomMask(Rng &rng)
+{
+    int w = 1 + rng.bounded(SpriteMask::MaxWidth);
+    int h = 1 + rng.bounded(8);
+    SpriteMask mask(rng.bounded(21) - 10, rng.bounded(21) - 10, w, h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            if (rng.bounded(3) == 0) mask.setCell(mask.left() + x, mask.top() + y);
+    mask.setCell(mask.left() + w - 1, mask.top()); // keep the last column in play
+    return mask;
+}
+
+// --- Construction ---
+
+void SpriteMaskTest::fromCellsBounds()
+{
+    std::vector<QPoint> cells = { QPoint(-2, 3), QPoint(5, 1), QPoint(0, 7), QPoint(5, 7) };
+    SpriteMask mask = SpriteMask::fromCells(cells);
+
+    QCOMPARE(mask.left(), -2);
+    QCOMPARE(mask.top(), 1);
+    QCOMPARE(mask.width(), 8);
+    QCOMPARE(mask.height(), 7);
+    QVERIFY(!mask.isEmpty());
+
+    int set = 0;
+    for (int y = mask.top(); y < mask.top() + mask.height(); ++y)
+        for (int x = mask.left(); x < mask.left() + mask.width(); ++x)
+            if (mask.testCell(x, y)) set++;
+    QCOMPARE(set, int(cells.size()));
+    for (const QPoint &c : cells) QVERIFY(mask.testCell(c.x(), c.y()));
+}
+
+void SpriteMaskTest::fromCellsEmpty()
+{
+    SpriteMask mask = SpriteMask::fromCells(std::vector<QPoint>());
+    QVERIFY(mask.isEmpty());
+    QCOMPARE(mask.width(), 0);
+    QCOMPARE(mask.overlapRect(QPoint(0, 0), -100, -100, 200, 200), 0);
+}
+
+void SpriteMaskTest::testCellOutsideMask()
+{
+    SpriteMask mask(-3, 2, 4, 2); // x -3..0, y 2..3
+    for (int y = 2; y < 4; ++y)
+        for (int x = -3; x < 1; ++x) mask.setCell(x, y);
+
+    QVERIFY(mask.testCell(-3, 2));
+    QVERIFY(mask.testCell(0, 3));
+    QVERIFY(!mask.testCell(-4, 2)); // left of the box
+    QVERIFY(!mask.testCell(1, 2));  // right of the box
+    QVERIFY(!mask.testCell(0, 1));  // above
+    QVERIFY(!mask.testCell(0, 4));  // below
+    QVERIFY(!mask.testCell(-3 + 64, 2)); // would be a valid bit index, but outside the width
+    QVERIFY(!SpriteMask().testCell(0, 0));
+}
+
+// --- Queries ---
+
+// A 3x2 block at local (0,0) placed at (10,20); rects around it
+void SpriteMaskTest::overlapRect_data()
+{
+    QTest::addColumn<QRect>("rect");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("covers") << QRect(0, 0, 100, 100) << 6;
+    QTest::newRow("exact") << QRect(10, 20, 3, 2) << 6;
+    QTest::newRow("left-part") << QRect(5, 0, 6, 100) << 2;      // column 10 only
+    QTest::newRow("right-part") << QRect(12, 21, 50, 50) << 1;   // bottom right cell
+    QTest::newRow("top-part") << QRect(11, 10, 1, 11) << 1;      // column 11, row 20
+    QTest::newRow("inside") << QRect(11, 20, 1, 2) << 2;
+    QTest::newRow("touching-left") << QRect(0, 20, 10, 2) << 0;
+    QTest::newRow("touching-below") << QRect(10, 22, 3, 5) << 0;
+    QTest::newRow("empty-rect") << QRect(10, 20, 0, 2) << 0;
+}
+
+void SpriteMaskTest::overlapRect()
+{
+    QFETCH(QRect, rect);
+    QFETCH(int, expected);
+
+    SpriteMask mask(0, 0, 3, 2);
+    for (int y = 0; y < 2; ++y)
+        for (int x = 0; x < 3; ++x) mask.setCell(x, y);
+
+    QCOMPARE(mask.overlapRect(QPoint(10, 20), rect.x(), rect.y(), rect.width(), rect.height()), expected);
+}
+
+// Two 1-row masks, ours fixed at the origin and theirs moved sideways by dx,
+// so the shift inside overlapMask() is negative, zero or positive
+void SpriteMaskTest::overlapMask_data()
+{
+    QTest::addColumn<int>("dx");
+    QTest::addColumn<int>("expected");
+
+    // ours: columns 0..7 set; theirs: columns 0, 2, 4 set
+    QTest::newRow("-5") << -5 << 0;
+    QTest::newRow("-4") << -4 << 1;  // their column 4 on our 0
+    QTest::newRow("-1") << -1 << 2;
+    QTest::newRow("0") << 0 << 3;
+    QTest::newRow("+3") << 3 << 3;
+    QTest::newRow("+5") << 5 << 2;   // their 4 lands on 9, outside
+    QTest::newRow("+7") << 7 << 1;
+    QTest::newRow("+8") << 8 << 0;
+    QTest::newRow("+64") << 64 << 0;
+    QTest::newRow("-64") << -64 << 0;
+}
+
+void SpriteMaskTest::overlapMask()
+{
+    QFETCH(int, dx);
+    QFETCH(int, expected);
+
+    SpriteMask ours(0, 0, 8, 1);
+    for (int x = 0; x < 8; ++x) ours.setCell(x, 0);
+    SpriteMask theirs = SpriteMask::fromCells({ QPoint(0, 0), QPoint(2, 0), QPoint(4, 0) });
+
+    QCOMPARE(ours.overlapMask(QPoint(0, 0), theirs, QPoint(dx, 0)), expected);
+    QCOMPARE(theirs.overlapMask(QPoint(dx, 0), ours, QPoint(0, 0)), expected); // symmetric
+    QCOMPARE(ours.overlaps(QPoint(0, 0), theirs, QPoint(dx, 0)), expected > 0);
+}
+
+// Bit 63 of a full-width mask: the edge of the row word
+void SpriteMaskTest::lastColumn()
+{
+    SpriteMask wide(0, 0, SpriteMask::MaxWidth, 1);
+    wide.setCell(0, 0);
+    wide.setCell(63, 0);
+    QVERIFY(wide.testCell(63, 0));
+    QVERIFY(!wide.testCell(64, 0));
+
+    QCOMPARE(wide.overlapRect(QPoint(0, 0), 63, 0, 1, 1), 1);
+    QCOMPARE(wide.overlapRect(QPoint(0, 0), 63, 0, 100, 1), 1);
+    QCOMPARE(wide.overlapRect(QPoint(0, 0), 0, 0, 64, 1), 2);
+    QCOMPARE(wide.overlapRect(QPoint(0, 0), -10, 0, 200, 1), 2);
+    QCOMPARE(wide.overlapRect(QPoint(0, 0), 64, 0, 10, 1), 0);
+
+    SpriteMask dot = SpriteMask::fromCells({ QPoint(0, 0) });
+    QCOMPARE(wide.overlapMask(QPoint(0, 0), dot, QPoint(63, 0)), 1);  // shift +63
+    QCOMPARE(wide.overlapMask(QPoint(0, 0), dot, QPoint(64, 0)), 0);  // just past the edge
+    QCOMPARE(dot.overlapMask(QPoint(63, 0), wide, QPoint(0, 0)), 1);  // shift -63
+    QCOMPARE(dot.overlapMask(QPoint(-1, 0), wide, QPoint(0, 0)), 0);
+
+    // Two full-width masks sliding past each other: their 63 meets our 0
+    QCOMPARE(wide.overlapMask(QPoint(0, 0), wide, QPoint(-63, 0)), 1);
+    QCOMPARE(wide.overlapMask(QPoint(0, 0), wide, QPoint(63, 0)), 1);
+    QCOMPARE(wide.overlapMask(QPoint(0, 0), wide, QPoint(0, 0)), 2);
+}
+
+// Random masks at random offsets, against the cell-by-cell counts
+void SpriteMaskTest::matchesCellByCell()
+{
+    Rng rng(20240517);
+    for (int round = 0; round < 2000; ++round) {
+        SpriteMask a = randomMask(rng);
+        SpriteMask b = randomMask(rng);
+        QPoint aPos(rng.bounded(41) - 20, rng.bounded(11) - 5);
+        QPoint bPos(aPos.x() + rng.bounded(161) - 80, aPos.y() + rng.bounded(21) - 10);
+        QCOMPARE(a.overlapMask(aPos, b, bPos), countBoth(a, aPos, b, bPos));
+
+        QRect rect(aPos.x() + rng.bounded(101) - 50, aPos.y() + rng.bounded(21) - 10,
+                   rng.bounded(80), rng.bounded(12));
+        QCOMPARE(a.overlapRect(aPos, rect.x(), rect.y(), rect.width(), rect.height()),
+                 countInRect(a, aPos, rect));
+    }
+}
+
+QTEST_APPLESS_MAIN(SpriteMaskTest)
+
+#include "spritemasktest.moc"
@@ -0,0 +1,10 @@
+# SpriteMask collision queries against a cell-by-cell reference
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+SOURCES += \
+    spritemasktest.cpp
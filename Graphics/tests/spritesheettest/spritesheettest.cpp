@@ -0,0 +1,188 @@
+#include "spritesheet.h"
+#include "spritepack.h"
+
+#include <QtTest>
+#include <QFile>
+
+// SpriteSheet::load() on a small hand-built sheet and on damaged copies of
+// it, plus the shipped dino sheet against its text source.
+class SpriteSheetTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loadsValidSheet();
+    void rejectsBadInput_data();
+    void rejectsBadInput();
+    void rejectsEveryTruncation();
+    void dinoSheet();
+    void dinoSourceMatchesSheet();
+    void packRejectsBadSource_data();
+    void packRejectsBadSource();
+
+private:
+    // Byte offsets in validSheet()
+    enum { Version = 4, FrameCount = 6, FrameHeader = 16, Width = 18, CellCount = 22, Rows = 24, Colors = 40 };
+    static QByteArray validSheet();
+    static bool load(SpriteSheet &sheet, const QByteArray &data)
+    {
+        return sheet.load(reinterpret_cast<const uchar *>(data.constData()), data.size());
+    }
+};
+
+// Two colours, one Running frame of 3 x 2 cells around the anchor:
+//     X.X    (row -1)
+//     XX.    (row 0)
+//    ^ column -1
+QByteArray SpriteSheetTest::validSheet()
+{
+    const uchar bytes[] = {
+        'D', 'S', 'P', 'R', 1, 2, 1, 0,                 // magic, version, palette size, frames, reserved
+        0x6a, 0xb0, 0x23, 0xff, 0x00, 0x00, 0xff, 0xff, // palette: ff23b06a, ffff0000
+        1, 3, 3, 2, 0xff, 0xff, 4, 0,                   // Running, 3 ticks, 3 x 2 at (-1,-1), 4 cells
+        0x05, 0, 0, 0, 0, 0, 0, 0,                      // row -1: columns -1 and 1
+        0x03, 0, 0, 0, 0, 0, 0, 0,                      // row 0: columns -1 and 0
+        0, 1, 1, 0                                      // palette index per cell
+    };
+    return QByteArray(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+void SpriteSheetTest::loadsValidSheet()
+{
+    SpriteSheet sheet;
+    QVERIFY2(load(sheet, validSheet()), qPrintable(sheet.errorString()));
+    QCOMPARE(sheet.palette().size(), size_t(2));
+    QCOMPARE(sheet.palette()[0], quint32(0xff23b06a));
+    QCOMPARE(sheet.frameCount(), 1);
+
+    const SpriteSheet::Frame &frame = sheet.frame(0);
+    QCOMPARE(frame.animation, SpriteSheet::Running);
+    QCOMPARE(frame.ticks, 3);
+    std::vector<QPoint> cells = { QPoint(-1, -1), QPoint(1, -1), QPoint(-1, 0), QPoint(0, 0) };
+    QVERIFY(frame.cells == cells);
+    std::vector<quint8> colors = { 0, 1, 1, 0 };
+    QVERIFY(frame.colors == colors);
+    QCOMPARE(frame.mask.left(), -1);
+    QCOMPARE(frame.mask.top(), -1);
+    QVERIFY(frame.mask.testCell(1, -1));
+    QVERIFY(!frame.mask.testCell(0, -1));
+}
+
+void SpriteSheetTest::rejectsBadInput_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    const QByteArray valid = validSheet();
+    QByteArray b;
+
+    QTest::newRow("empty") << QByteArray();
+    b = valid; b[1] = 'X';
+    QTest::newRow("bad magic") << b;
+    b = valid; b[Version] = 2;
+    QTest::newRow("bad version") << b;
+    b = valid; b[FrameCount] = 0;
+    QTest::newRow("no frames") << b;
+    QTest::newRow("truncated palette") << valid.left(FrameHeader - 2);
+    QTest::newRow("truncated frame header") << valid.left(FrameHeader + 5);
+    QTest::newRow("truncated rows") << valid.left(Rows + 12);
+    QTest::newRow("truncated colours") << valid.left(Colors + 2);
+    b = valid; b[FrameCount] = 2;
+    QTest::newRow("second frame missing") << b;
+
+    b = valid; b[FrameHeader] = SpriteSheet::AnimationCount;
+    QTest::newRow("unknown animation") << b;
+    b = valid; b[FrameHeader + 1] = 0;
+    QTest::newRow("zero ticks") << b;
+    b = valid; b[Width] = 0;
+    QTest::newRow("zero width") << b;
+    b = valid; b[Width] = SpriteMask::MaxWidth + 1;
+    QTest::newRow("too wide") << b;
+
+    // Cell count against the bits actually set; the data stays the right length
+    b = valid; b[CellCount] = 5; b.append(char(0));
+    QTest::newRow("more cells than bits") << b;
+    b = valid; b[CellCount] = 3; b.chop(1);
+    QTest::newRow("fewer cells than bits") << b;
+    b = valid; b[Rows] = char(0x05 | 0x08);
+    QTest::newRow("bit outside the width") << b;
+
+    b = valid; b[Colors + 1] = 2;
+    QTest::newRow("palette index out of range") << b;
+    b = valid; b[Colors + 3] = char(0xff);
+    QTest::newRow("palette index 255") << b;
+}
+
+void SpriteSheetTest::rejectsBadInput()
+{
+    QFETCH(QByteArray, data);
+
+    SpriteSheet sheet;
+    QVERIFY(!load(sheet, data));
+    QVERIFY(!sheet.errorString().isEmpty());
+    QCOMPARE(sheet.frameCount(), 0); // nothing half-loaded is left behind
+}
+
+void SpriteSheetTest::rejectsEveryTruncation()
+{
+    const QByteArray valid = validSheet();
+    for (int size = 0; size < valid.size(); ++size) {
+        SpriteSheet sheet;
+        QVERIFY2(!load(sheet, valid.left(size)), qPrintable(QString("loaded the first %1 bytes").arg(size)));
+    }
+}
+
+// --- The shipped sheet ---
+
+void SpriteSheetTest::dinoSheet()
+{
+    const SpriteSheet &dino = SpriteSheet::dino();
+    QCOMPARE(dino.frameCount(), 3);
+    QCOMPARE(dino.frameAt(SpriteSheet::Standing, 5), 0);
+
+    // Two running frames of 4 ticks each, looping
+    const int running[] = { 1, 1, 1, 1, 2, 2, 2, 2, 1 };
+    for (int tick = 0; tick < 9; ++tick) QCOMPARE(dino.frameAt(SpriteSheet::Running, tick), running[tick]);
+
+    QCOMPARE(dino.frameAt(SpriteSheet::Ducking, 3), 0); // no ducking frames: falls back to Standing
+}
+
+// dino.sprites must be what spritepack makes of dino.sprites.txt
+void SpriteSheetTest::dinoSourceMatchesSheet()
+{
+    QFile source(QFINDTESTDATA("../../dino.sprites.txt"));
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QString error;
+    QByteArray packed = packSpriteSheet(source.readAll(), &error);
+    QVERIFY2(!packed.isEmpty(), qPrintable(error));
+
+    QFile sheet(":/sprites/dino.sprites");
+    QVERIFY(sheet.open(QIODevice::ReadOnly));
+    QCOMPARE(packed, sheet.readAll());
+}
+
+void SpriteSheetTest::packRejectsBadSource_data()
+{
+    QTest::addColumn<QByteArray>("source");
+
+    QTest::newRow("no palette") << QByteArray("frame standing 1 0 0\nX\n");
+    QTest::newRow("no frames") << QByteArray("palette X ff000000\n");
+    QTest::newRow("colour not in palette") << QByteArray("palette X ff000000\nframe standing 1 0 0\nXY\n");
+    QTest::newRow("unknown animation") << QByteArray("palette X ff000000\nframe jumping 1 0 0\nX\n");
+    QTest::newRow("zero ticks") << QByteArray("palette X ff000000\nframe standing 0 0 0\nX\n");
+    QTest::newRow("row before any frame") << QByteArray("palette X ff000000\nX\nframe standing 1 0 0\nX\n");
+    QTest::newRow("frame without cells") << QByteArray("palette X ff000000\nframe standing 1 0 0\n...\n");
+    QTest::newRow("duplicate colour") << QByteArray("palette X ff000000\npalette X ffffffff\nframe standing 1 0 0\nX\n");
+    QTest::newRow("too wide") << QByteArray("palette X ff000000\nframe standing 1 0 0\nX" + QByteArray(64, '.') + "X\n");
+}
+
+void SpriteSheetTest::packRejectsBadSource()
+{
+    QFETCH(QByteArray, source);
+
+    QString error;
+    QVERIFY(packSpriteSheet(source, &error).isEmpty());
+    QVERIFY(!error.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(SpriteSheetTest)
+
+#include "spritesheettest.moc"
@@ -0,0 +1,16 @@
+# SpriteSheet decoding: the shipped dino sheet, its text source, and bad input
+QT = core testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core.pri)
+
+INCLUDEPATH += $$PWD/../../tools/spritepack
+
+SOURCES += \
+    ../../tools/spritepack/spritepack.cpp \
+    spritesheettest.cpp
+
+HEADERS += \
+    ../../tools/spritepack/spritepack.h
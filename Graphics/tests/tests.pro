@@ -0,0 +1,8 @@
+# Unit tests (Qt Test). Build and run them all with  qmake && make check
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    blockbatchertest \
+    invincibilitytest \
+    spritemasktest \
+    spritesheettest
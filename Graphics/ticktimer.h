@@ -0,0 +1,29 @@
+#ifndef TICKTIMER_H
+#define TICKTIMER_H
+
+// Countdown in simulation ticks for per-entity effects (invincibility,
+// damage flashing, ...). The owner calls step() once per tick from its
+// update, so an effect follows simulation time rather than the wall clock:
+// it replays exactly, needs no event-loop timer, and keeps up when ticks
+// run faster than real time in the headless tools.
+class TickTimer
+{
+public:
+    static int ticksFor(int ms, int tickMs) { return (ms + tickMs - 1) / tickMs; } // rounded up
+
+    void start(int ticks) { remaining = ticks; }
+    void stop() { remaining = 0; }
+    bool isActive() const { return remaining > 0; }
+    int remainingTicks() const { return remaining; }
+
+    bool step() // counts one tick; true on the tick it runs out
+    {
+        if (remaining <= 0) return false;
+        return --remaining == 0;
+    }
+
+private:
+    int remaining = 0;
+};
+
+#endif // TICKTIMER_H
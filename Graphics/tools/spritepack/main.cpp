@@ -0,0 +1,46 @@
+#include "spritepack.h"
+#include "spritesheet.h"
+
+#include <QFile>
+#include <QDebug>
+
+// Usage: spritepack SOURCE OUTPUT
+// Packs a sprite sheet's text source (e.g. dino.sprites.txt) into the binary
+// sheet the game loads (e.g. dino.sprites), after checking that
+// SpriteSheet reads it back.
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        qWarning() << "Usage: spritepack SOURCE OUTPUT";
+        return 2;
+    }
+    QString sourcePath = QString::fromLocal8Bit(argv[1]);
+    QString outputPath = QString::fromLocal8Bit(argv[2]);
+
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not read" << sourcePath << ":" << source.errorString();
+        return 1;
+    }
+    QString error;
+    QByteArray sheet = packSpriteSheet(source.readAll(), &error);
+    if (sheet.isEmpty()) {
+        qWarning().noquote() << sourcePath + ":" << error;
+        return 1;
+    }
+
+    // Read it back exactly as the game will
+    SpriteSheet check;
+    if (!check.load(reinterpret_cast<const uchar *>(sheet.constData()), sheet.size())) {
+        qWarning().noquote() << "Packed sheet does not load:" << check.errorString();
+        return 1;
+    }
+
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly) || output.write(sheet) != sheet.size()) {
+        qWarning() << "Could not write" << outputPath << ":" << output.errorString();
+        return 1;
+    }
+    qInfo() << "Wrote" << check.frameCount() << "frames," << sheet.size() << "bytes to" << outputPath;
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "spritepack.h"
+#include "spritemask.h"
+#include "spritesheet.h"
+
+#include <QList>
+
+// C++ Standard Library includes
+#include <climits>      // For INT_MAX
+#include <vector>
+
+// Must match SpriteSheet::load() (spritesheet.cpp)
+static const char SHEET_MAGIC[4] = { 'D', 'S', 'P', 'R' };
+static const quint8 SHEET_VERSION = 1;
+
+namespace {
+struct SourceFrame {
+    int line = 0; // of the "frame" line, for errors
+    SpriteSheet::Animation animation = SpriteSheet::Standing;
+    int ticks = 1;
+    int anchorX = 0, anchorY = 0;
+    QList<QByteArray> rows;
+    std::vector<int> rowLines;
+};
+
+void put(QByteArray &out, quint64 value, int bytes) // little endian
+{
+    for (int i = 0; i < bytes; ++i) out.append(char((value >> (8 * i)) & 0xff));
+}
+}
+
+QByteArray packSpriteSheet(const QByteArray &source, QString *error)
+{
+    auto fail = [error](int line, const QString &what) {
+        if (error) *error = line > 0 ? QString("line %1: %2").arg(line).arg(what) : what;
+        return QByteArray();
+    };
+
+    QByteArray paletteChars; // palette index -> character
+    std::vector<quint32> palette;
+    std::vector<SourceFrame> frames;
+
+    // --- Parse ---
+    const QList<QByteArray> lines = source.split('\n');
+    for (int i = 0; i < lines.size(); ++i) {
+        int line = i + 1;
+        QByteArray text = lines[i].trimmed();
+        if (text.isEmpty() || text.startsWith('#')) continue;
+        QList<QByteArray> words = text.simplified().split(' ');
+
+        if (words[0] == "palette") {
+            bool ok = false;
+            quint32 argb = words.size() == 3 ? words[2].toUInt(&ok, 16) : 0;
+            if (!ok || words[1].size() != 1) return fail(line, "expected: palette <char> <AARRGGBB>");
+            char c = words[1][0];
+            if (c == '.' || c == '#' || paletteChars.contains(c)) return fail(line, QString("'%1' cannot be a palette character").arg(c));
+            if (palette.size() == 255) return fail(line, "more than 255 colours");
+            paletteChars.append(c);
+            palette.push_back(argb);
+        } else if (words[0] == "frame") {
+            static const char *animations[SpriteSheet::AnimationCount] = { "standing", "running", "ducking" };
+            SourceFrame frame;
+            frame.line = line;
+            int animation = -1;
+            bool ticksOk = false, xOk = false, yOk = false;
+            if (words.size() == 5) {
+                for (int a = 0; a < SpriteSheet::AnimationCount; ++a) {
+                    if (words[1] == animations[a]) animation = a;
+                }
+                frame.ticks = words[2].toInt(&ticksOk);
+                frame.anchorX = words[3].toInt(&xOk);
+                frame.anchorY = words[4].toInt(&yOk);
+            }
+            if (animation < 0 || !ticksOk || !xOk || !yOk || frame.ticks < 1 || frame.ticks > 255)
+                return fail(line, "expected: frame <standing|running|ducking> <ticks 1..255> <anchor column> <anchor row>");
+            if (frames.size() == 255) return fail(line, "more than 255 frames");
+            frame.animation = SpriteSheet::Animation(animation);
+            frames.push_back(frame);
+        } else if (words.size() == 1 && !frames.empty()) {
+            frames.back().rows.append(text);
+            frames.back().rowLines.push_back(line);
+        } else {
+            return fail(line, "expected a palette line, a frame line or a row of cells");
+        }
+    }
+    if (palette.empty()) return fail(0, "no palette");
+    if (frames.empty()) return fail(0, "no frames");
+
+    // --- Write ---
+    QByteArray out(SHEET_MAGIC, 4);
+    put(out, SHEET_VERSION, 1);
+    put(out, palette.size(), 1);
+    put(out, frames.size(), 1);
+    put(out, 0, 1); // reserved
+    for (quint32 argb : palette) put(out, argb, 4);
+
+    for (const SourceFrame &frame : frames) {
+        // Box around the frame's cells; empty rows and columns around it are dropped
+        int x0 = INT_MAX, y0 = INT_MAX, x1 = -1, y1 = -1;
+        for (int y = 0; y < frame.rows.size(); ++y) {
+            const QByteArray &row = frame.rows[y];
+            for (int x = 0; x < row.size(); ++x) {
+                if (row[x] == '.') continue;
+                if (!paletteChars.contains(row[x])) return fail(frame.rowLines[y], QString("'%1' is not in the palette").arg(row[x]));
+                x0 = qMin(x0, x); x1 = qMax(x1, x);
+                y0 = qMin(y0, y); y1 = qMax(y1, y);
+            }
+        }
+        if (x1 < 0) return fail(frame.line, "frame has no cells");
+
+        int width = x1 - x0 + 1, height = y1 - y0 + 1;
+        int left = x0 - frame.anchorX, top = y0 - frame.anchorY;
+        if (width > SpriteMask::MaxWidth || height > 255)
+            return fail(frame.line, QString("frame is larger than %1 x 255 cells").arg(SpriteMask::MaxWidth));
+        if (left < -128 || left > 127 || top < -128 || top > 127)
+            return fail(frame.line, "anchor is too far from the frame's cells");
+
+        QByteArray rowBits, cellColors;
+        for (int y = y0; y <= y1; ++y) {
+            const QByteArray &row = frame.rows[y];
+            quint64 bits = 0;
+            for (int x = x0; x <= x1 && x < row.size(); ++x) {
+                if (row[x] == '.') continue;
+                bits |= quint64(1) << (x - x0);
+                cellColors.append(char(paletteChars.indexOf(row[x])));
+            }
+            put(rowBits, bits, 8);
+        }
+
+        put(out, frame.animation, 1);
+        put(out, frame.ticks, 1);
+        put(out, width, 1);
+        put(out, height, 1);
+        put(out, quint8(qint8(left)), 1);
+        put(out, quint8(qint8(top)), 1);
+        put(out, cellColors.size(), 2); // at most 64 x 255 cells
+        out.append(rowBits);
+        out.append(cellColors);
+    }
+    return out;
+}
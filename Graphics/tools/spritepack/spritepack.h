@@ -0,0 +1,14 @@
+#ifndef SPRITEPACK_H
+#define SPRITEPACK_H
+
+#include <QByteArray>
+#include <QString>
+
+// Turns a sprite sheet's text source (palette lines, then frames drawn as
+// rows of characters; see dino.sprites.txt for the syntax) into the binary
+// layout SpriteSheet loads. Each frame is trimmed to the box around its
+// cells. Returns an empty array, with the line at fault in error, if the
+// source is not a valid sheet.
+QByteArray packSpriteSheet(const QByteArray &source, QString *error);
+
+#endif // SPRITEPACK_H
@@ -0,0 +1,19 @@
+# Packs a sprite sheet's text source into the binary layout SpriteSheet loads:
+#     spritepack ../../dino.sprites.txt ../../dino.sprites
+QT = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    ../../spritemask.cpp \
+    ../../spritesheet.cpp \
+    main.cpp \
+    spritepack.cpp
+
+HEADERS += \
+    ../../spritemask.h \
+    ../../spritesheet.h \
+    spritepack.h
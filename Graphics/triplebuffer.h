@@ -0,0 +1,47 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer triple buffer.
+// The producer fills back() and publish()es it; the consumer calls update()
+// and, if it returns true, reads the newer front(). Neither side ever waits
+// and each owns its slot exclusively; if the producer is faster, frames the
+// consumer never picked up are simply overwritten (latest wins).
+template <class T>
+class TripleBuffer
+{
+public:
+    explicit TripleBuffer(const T &initial = T())
+        : buffers{{ initial, initial, initial }}, backIdx(0), frontIdx(1), middle(2) {}
+
+    // --- Producer side ---
+    T &back() { return buffers[backIdx]; }
+    int backIndex() const { return backIdx; } // stable slot id, e.g. for per-slot bookkeeping
+    void publish()
+    {
+        int old = middle.exchange(backIdx | FreshBit, std::memory_order_acq_rel);
+        backIdx = old & IndexMask;
+    }
+
+    // --- Consumer side ---
+    bool update() // true if a newer slot was swapped into front()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FreshBit)) return false;
+        int old = middle.exchange(frontIdx, std::memory_order_acq_rel);
+        frontIdx = old & IndexMask;
+        return true;
+    }
+    T &front() { return buffers[frontIdx]; }
+
+private:
+    enum { IndexMask = 3, FreshBit = 4 };
+
+    std::array<T, 3> buffers;
+    int backIdx;  // producer only
+    int frontIdx; // consumer only
+    std::atomic<int> middle; // slot in between, plus FreshBit if it holds an unread publish()
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,95 @@
+#include "vectorscene.h"
+
+// C++ Standard Library includes
+#include <algorithm>    // For std::max
+
+static const int DINO_GROUND = 350; // where Dino builds its shape; it is moved from there
+
+VectorScene::VectorScene()
+    : dino(QRect(50, DINO_GROUND - 50, 40, 50), 1.f, -18.f, DINO_GROUND)
+{
+}
+
+void VectorScene::sync(const GameWorld &world, int dinoShiftY, int scrollShiftX, int weaponShiftX)
+{
+    int gap = world.gap, half = gap / 2;
+    // Pixel edges of grid cells (see GameWorld::from_grid: cells are centred on it)
+    auto left = [&](int x) { return world.from_grid(x, 0).x() - half; };
+    auto top = [&](int y) { return world.from_grid(0, y).y() - half; };
+
+    // Dino: right edge on the grid dino's snout, feet on the cell it stands on
+    QRect box = dino.getRect();
+    dino.moveTo(left(world.dino_x + 2) - box.width(), top(world.dino_y + 1) - 1 + dinoShiftY);
+    dino.setLives(world.lives);
+    dino.setFlash(world.dinoFlash); // in step with the grid style's flicker
+
+    shield = QRect();
+    if (world.haveShield) {
+        int r = 5 * gap; // drawShield() default radius
+        QPoint c = world.from_grid(world.dino_x, world.dino_y - 3) + QPoint(0, dinoShiftY);
+        shield = QRect(c.x() - r, c.y() - r, 2 * r, 2 * r);
+    }
+
+    obstacles.clear();
+    for (const Obstacle &ob : world.obstacles) {
+        if (ob.destroyed) continue;
+        int floor = top(world.floorY(ob.x));
+        obstacles.push_back(PixelObstacle(QRect(left(ob.x) + scrollShiftX, floor - ob.height * gap, gap, ob.height * gap)));
+    }
+
+    weapons.clear();
+    for (const Weapon &w : world.weapons) {
+        if (w.used) continue;
+        weapons.push_back(QRect(left(w.x) + weaponShiftX, top(w.y), 4 * gap, gap));
+    }
+
+    ground = QRect(left(world.min_x), top(world.ground_y), (world.max_x - world.min_x + 1) * gap, gap);
+
+    // Hills: one polygon along the top of every column, closed along the ground line
+    hills.clear();
+    if (world.terrain.highest() > 0) {
+        int base = top(world.ground_y);
+        hills << QPoint(left(world.min_x - 5) + scrollShiftX, base);
+        for (int x = world.min_x - 5; x <= world.max_x; ++x) {
+            int y = top(world.floorY(x));
+            hills << QPoint(left(x) + scrollShiftX, y) << QPoint(left(x + 1) + scrollShiftX, y);
+        }
+        hills << QPoint(left(world.max_x + 1) + scrollShiftX, base);
+    }
+}
+
+QRegion VectorScene::objectRegion() const
+{
+    QRegion region;
+    region += dino.getRect().adjusted(-1, -1, 1, 1); // outline pen
+    region += dino.livesRect().adjusted(-1, -1, 1, 1);
+    if (!shield.isNull()) region += shield.adjusted(-2, -2, 2, 2);
+    for (const PixelObstacle &ob : obstacles) region += ob.getRect();
+    for (const QRect &w : weapons) region += w;
+    if (!hills.isEmpty()) region += hills.boundingRect();
+    return region;
+}
+
+void VectorScene::draw(QPainter &painter)
+{
+    painter.fillRect(ground, Qt::black);
+    if (!hills.isEmpty()) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(100, 100, 100)); // Grey
+        painter.drawPolygon(hills);
+    }
+
+    for (PixelObstacle &ob : obstacles) ob.draw(painter);
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(255, 140, 0)); // fireball orange
+    for (const QRect &w : weapons) painter.drawRect(w);
+
+    dino.draw(painter);
+
+    if (!shield.isNull()) {
+        painter.setPen(QPen(Qt::blue, 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawEllipse(shield);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef VECTORSCENE_H
+#define VECTORSCENE_H
+
+#include <QPainter>
+#include <QPolygon>
+#include <QRegion>
+#include <vector>
+#include "dino.h"
+#include "obstacle.h"
+#include "gameworld.h"
+
+// GameRenderer's vector style: draws a GameWorld in pixel space with the
+// polygon Dino and PixelObstacle classes, one drawPolygon()/drawRect() per
+// entity instead of one batched block per grid cell. The world is still
+// simulated on the grid; sync() just places the entities where the world
+// has them each frame, so both styles show the same (replayable) run.
+class VectorScene
+{
+public:
+    VectorScene();
+
+    // Places everything for this frame; the shifts are GameRenderer's
+    // in-between-ticks pixel offsets
+    void sync(const GameWorld &world, int dinoShiftY, int scrollShiftX, int weaponShiftX);
+    QRegion objectRegion() const; // everything sync() placed, pen included
+    void draw(QPainter &painter); // ground, hills, obstacles, weapons, dino and shield
+
+private:
+    Dino dino;
+    std::vector<PixelObstacle> obstacles; // rebuilt every sync(); capacity is kept
+    std::vector<QRect> weapons;
+    QRect ground;
+    QPolygon hills; // outline of the terrain band, empty when it is flat
+    QRect shield;   // ellipse bounds, null when there is none
+};
+
+#endif // VECTORSCENE_H
@@ -0,0 +1,86 @@
+#include "worldgen.h"
+
+#include <algorithm>    // For std::max, std::min
+
+// SplitMix64 finaliser: a well-mixed value for each (seed, lattice point)
+static quint64 mix(quint64 x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static quint64 runSeed(const WorldGenerator::Config &config)
+{
+    return mix(config.seed ^ (quint64(config.run) << 32)); // every run gets its own world
+}
+
+ChunkState WorldGenerator::start(const Config &config)
+{
+    ChunkState state;
+    state.rng.setSeed(runSeed(config));
+    state.untilSpawn = config.firstSpawn;
+    return state;
+}
+
+void WorldGenerator::generate(const Config &config, const ChunkState &before, qint64 index, WorldChunk &out)
+{
+    quint64 noiseSeed = mix(runSeed(config) ^ 0x7465727261696eULL);
+    ChunkState s = before;
+    out.run = config.run;
+    out.index = index;
+    out.obstacleCount = 0;
+
+    auto addObstacle = [&](int column, int height) {
+        out.obstacleColumn[out.obstacleCount] = quint8(column);
+        out.obstacleHeight[out.obstacleCount] = quint8(height);
+        out.obstacleCount++;
+    };
+
+    for (int c = 0; c < WorldChunk::Width; ++c) {
+        qint64 column = index * WorldChunk::Width + c;
+
+        // Terrain: step at most one cell towards the noise, so every slope is walkable
+        int target = targetHeight(noiseSeed, column);
+        if (target > s.height) s.height++;
+        else if (target < s.height) s.height--;
+        out.heights[c] = quint8(s.height);
+
+        // Obstacles: singles, or later on groups of 3-4 short ones 8-11 columns apart
+        if (s.groupLeft > 0) {
+            if (--s.groupGap <= 0) {
+                addObstacle(c, s.rng.bounded(3) + 2); // 2, 3, or 4 blocks high
+                s.groupLeft--;
+                s.groupGap = 8 + s.rng.bounded(4);
+            }
+        } else if (--s.untilSpawn <= 0) {
+            if (column >= config.multiSpawnFrom && s.rng.bounded(4) == 0) {
+                addObstacle(c, s.rng.bounded(3) + 2);
+                s.groupLeft = 2 + s.rng.bounded(2); // 3 or 4 in all
+                s.groupGap = 8 + s.rng.bounded(4);
+            } else {
+                addObstacle(c, s.rng.bounded(4) + 4); // 4, 5, 6, or 7 blocks high
+            }
+            s.untilSpawn = config.minSpacing + s.rng.bounded(config.randomSpacing);
+        }
+    }
+    out.after = s;
+}
+
+int WorldGenerator::targetHeight(quint64 noiseSeed, qint64 column)
+{
+    if (column < FlatStart) return 0;
+
+    // 1D value noise: random values at every Period columns, smoothstepped in between
+    qint64 cell = column / Period;
+    double t = double(column % Period) / Period;
+    t = t * t * (3.0 - 2.0 * t);
+    double a = (mix(noiseSeed ^ quint64(cell)) >> 11) * (1.0 / 9007199254740992.0); // [0, 1)
+    double b = (mix(noiseSeed ^ quint64(cell + 1)) >> 11) * (1.0 / 9007199254740992.0);
+    double v = a + (b - a) * t;
+
+    // The lower third of the range is flat ground, the rest hills up to MaxHeight
+    int h = int((v - 0.35) / 0.65 * (MaxHeight + 1));
+    return std::min(std::max(h, 0), MaxHeight);
+}
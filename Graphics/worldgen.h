@@ -0,0 +1,67 @@
+#ifndef WORLDGEN_H
+#define WORLDGEN_H
+
+#include <QtGlobal>
+#include "rng.h"
+
+// Everything the generator carries from one chunk to the next
+struct ChunkState {
+    Rng rng;
+    int height = 0;     // terrain height of the last column
+    int untilSpawn = 0; // columns until the next obstacle (or group)
+    int groupLeft = 0;  // obstacles still to place in the current group
+    int groupGap = 0;   // columns until the next one of them
+};
+
+// A fixed-width slice of the world, in the order it scrolls in: terrain
+// heights for every column plus the obstacles standing in it. Plain data,
+// so chunks can be built on one thread and copied to another.
+struct WorldChunk {
+    static const int Width = 64; // columns
+    static const int MaxObstacles = Width / 8 + 1; // obstacles are at least 8 columns apart
+
+    quint32 run = 0;  // GameWorld::runNumber it belongs to
+    qint64 index = -1; // chunks since the start of the run
+    quint8 heights[Width];
+    int obstacleCount = 0;
+    quint8 obstacleColumn[MaxObstacles]; // 0..Width-1, ascending
+    quint8 obstacleHeight[MaxObstacles];
+    ChunkState after; // generator state for chunk index + 1
+};
+
+// Builds the world chunk by chunk. Chunk n depends only on the config and
+// on chunk n-1's `after` state, so whoever builds it (a worker thread ahead
+// of time, or GameWorld itself when none is ready) gets the same chunk.
+class WorldGenerator
+{
+public:
+    static const int MaxHeight = 8;    // terrain cells above the ground line
+    static const int Period = 48;      // columns between terrain noise lattice points
+    static const int FlatStart = 1000; // columns of flat ground at the start of a run
+
+    struct Config {
+        quint64 seed = 0;
+        quint32 run = 0;
+        int minSpacing = 100, randomSpacing = 80; // columns between obstacle spawns
+        int firstSpawn = 100;     // columns before the first obstacle
+        int multiSpawnFrom = 5000; // column from which groups of 3-4 can appear
+    };
+
+    static ChunkState start(const Config &config); // state before chunk 0
+    static void generate(const Config &config, const ChunkState &before, qint64 index, WorldChunk &out);
+
+private:
+    static int targetHeight(quint64 noiseSeed, qint64 column); // smooth noise the terrain follows
+};
+
+// Somewhere chunks built ahead of time can be taken from (see ChunkStreamer).
+// GameWorld builds a chunk itself whenever take() comes back empty-handed.
+class ChunkSource
+{
+public:
+    virtual ~ChunkSource() {}
+    virtual void restart(quint32 run) = 0; // a new run started; older chunks are useless now
+    virtual bool take(quint32 run, qint64 index, WorldChunk &out) = 0; // false if that chunk is not ready
+};
+
+#endif // WORLDGEN_H